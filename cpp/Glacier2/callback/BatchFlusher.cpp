@@ -0,0 +1,53 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "BatchFlusher.h"
+
+#include <iostream>
+
+using namespace std;
+
+Server::BatchFlusher::BatchFlusher(Ice::CommunicatorPtr communicator, chrono::milliseconds interval)
+    : _communicator{std::move(communicator)},
+      _interval{interval},
+      _thread{[this] { run(); }}
+{
+}
+
+Server::BatchFlusher::~BatchFlusher()
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _destroyed = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+void
+Server::BatchFlusher::run()
+{
+    unique_lock<mutex> lock(_mutex);
+    while (true)
+    {
+        bool destroyed = _condition.wait_for(lock, _interval, [this] { return _destroyed; });
+
+        // Flushing sends the queued batch requests without waiting for them to reach the peer.
+        try
+        {
+            _communicator->flushBatchRequests(Ice::CompressBatch::BasedOnProxy);
+        }
+        catch (const Ice::CommunicatorDestroyedException&)
+        {
+            break;
+        }
+        catch (const std::exception& ex)
+        {
+            cerr << "Failed to flush batch requests: " << ex.what() << endl;
+        }
+
+        if (destroyed)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef BATCH_FLUSHER_H
+#define BATCH_FLUSHER_H
+
+#include <Ice/Ice.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Server
+{
+    /// BatchFlusher flushes the batch oneway requests queued by a communicator at a fixed interval. All the batch
+    /// requests queued for the same connection during an interval travel in a single message.
+    class BatchFlusher final
+    {
+    public:
+        /// Constructs a BatchFlusher and starts its thread.
+        /// @param communicator The communicator.
+        /// @param interval The interval between two flushes.
+        BatchFlusher(Ice::CommunicatorPtr communicator, std::chrono::milliseconds interval);
+
+        /// Flushes the remaining batch requests and stops the thread.
+        ~BatchFlusher();
+
+        BatchFlusher(const BatchFlusher&) = delete;
+        BatchFlusher& operator=(const BatchFlusher&) = delete;
+
+    private:
+        void run();
+
+        const Ice::CommunicatorPtr _communicator;
+        const std::chrono::milliseconds _interval;
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _destroyed{false};
+
+        std::thread _thread; // must be the last member, since the thread uses the other members
+    };
+}
+
+#endif
@@ -0,0 +1,200 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "AlarmClock.h"
+
+#include <Glacier2/Glacier2.h>
+#include <Ice/Ice.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#    include <unistd.h>
+#endif
+
+using namespace EarlyRiser;
+using namespace std;
+
+namespace
+{
+    /// The number of callbacks sent in each run.
+    constexpr size_t callbackCount = 20000;
+
+    /// In batched mode, the benchmark flushes the batch after this number of callbacks.
+    constexpr size_t batchSize = 100;
+
+    /// TimingAlarmClock measures the latency of each display callback. The message of each callback is the time it
+    /// was sent, in nanoseconds since the epoch of the steady clock; the server and the client share this clock since
+    /// they run in the same process.
+    class TimingAlarmClock : public AlarmClock
+    {
+    public:
+        ButtonPressed ring(string, const Ice::Current&) final { return ButtonPressed::Stop; }
+
+        void display(string message, const Ice::Current&) final
+        {
+            auto now = chrono::steady_clock::now().time_since_epoch();
+            chrono::nanoseconds sentAt{stoll(message)};
+
+            const lock_guard<mutex> lock(_mutex);
+            _latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(now) - sentAt);
+            if (_latencies.size() == _expected)
+            {
+                _condition.notify_all();
+            }
+        }
+
+        /// Resets the latencies, and sets the number of callbacks to wait for.
+        void reset(size_t expected)
+        {
+            const lock_guard<mutex> lock(_mutex);
+            _latencies.clear();
+            _expected = expected;
+        }
+
+        /// Waits until all the expected callbacks arrived, or a timeout.
+        vector<chrono::nanoseconds> wait(chrono::seconds timeout)
+        {
+            unique_lock<mutex> lock(_mutex);
+            _condition.wait_for(lock, timeout, [this] { return _latencies.size() >= _expected; });
+            return _latencies;
+        }
+
+    private:
+        mutex _mutex;
+        condition_variable _condition;
+        vector<chrono::nanoseconds> _latencies;
+        size_t _expected{0};
+    };
+
+    /// Reads the CPU time consumed by a process, on Linux.
+    /// @param pid The process ID.
+    /// @return The CPU time, or nullopt if it's not available.
+    optional<chrono::milliseconds> readCpuTime([[maybe_unused]] const string& pid)
+    {
+#ifdef __linux__
+        ifstream stat{"/proc/" + pid + "/stat"};
+        string line;
+        if (!getline(stat, line))
+        {
+            return nullopt;
+        }
+
+        // Skip the process name, which is between parentheses and can contain spaces. utime and stime are the 12th and
+        // 13th fields after the name.
+        istringstream is{line.substr(line.rfind(')') + 2)};
+        string field;
+        for (int i = 0; i < 11; ++i)
+        {
+            is >> field;
+        }
+        long long utime = 0, stime = 0;
+        is >> utime >> stime;
+        return chrono::milliseconds{(utime + stime) * 1000 / sysconf(_SC_CLK_TCK)};
+#else
+        return nullopt;
+#endif
+    }
+
+    /// Sends callbackCount display callbacks and waits for them.
+    void run(
+        const char* label,
+        const AlarmClockPrx& alarmClock,
+        TimingAlarmClock& servant,
+        bool batched,
+        const string& routerPid)
+    {
+        servant.reset(callbackCount);
+        optional<chrono::milliseconds> cpuBefore = readCpuTime(routerPid);
+
+        AlarmClockPrx proxy = batched ? alarmClock->ice_batchOneway() : alarmClock->ice_oneway();
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < callbackCount; ++i)
+        {
+            proxy->display(to_string(chrono::steady_clock::now().time_since_epoch().count()));
+            if (batched && (i + 1) % batchSize == 0)
+            {
+                proxy->ice_flushBatchRequests();
+            }
+        }
+        if (batched)
+        {
+            proxy->ice_flushBatchRequests();
+        }
+
+        vector<chrono::nanoseconds> latencies = servant.wait(30s);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        optional<chrono::milliseconds> cpuAfter = readCpuTime(routerPid);
+
+        sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p)
+        {
+            return latencies.empty()
+                       ? 0
+                       : chrono::duration_cast<chrono::microseconds>(
+                             latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))])
+                             .count();
+        };
+
+        cout << "  " << left << setw(8) << label << right << setw(7) << latencies.size() << " received" << fixed
+             << setprecision(0) << setw(9) << static_cast<double>(latencies.size()) / elapsed.count()
+             << " callbacks/s" << setw(8) << percentile(0.5) << " us p50" << setw(8) << percentile(0.99)
+             << " us p99";
+        if (cpuBefore && cpuAfter)
+        {
+            cout << setprecision(2) << setw(7)
+                 << static_cast<double>((*cpuAfter - *cpuBefore).count()) * 1000.0 / static_cast<double>(callbackCount)
+                 << " router CPU ms per 1000 callbacks";
+        }
+        cout << endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    // The server and the client each use their own communicator, so that all the callbacks go through the Glacier2
+    // router.
+    Ice::InitializationData initData;
+    initData.properties = Ice::createProperties(argc, argv);
+    Ice::CommunicatorHolder server{Ice::initialize(initData)};
+    Ice::CommunicatorHolder client{Ice::initialize(initData)};
+
+    // The optional argument is the process ID of the Glacier2 router; on Linux, the benchmark reports the CPU time
+    // the router consumed.
+    string routerPid = argc > 1 ? argv[1] : "";
+
+    // Create a session and a callback object adapter, like the demo's client.
+    Glacier2::RouterPrx router{client.communicator(), "Glacier2/router:tcp -h localhost -p 4063"};
+    router->createSession("benchmark", "password");
+    string clientCategory = router->getCategoryForClient();
+    Ice::ObjectAdapterPtr adapter = client->createObjectAdapterWithRouter("", router);
+    adapter->activate();
+
+    auto servant = make_shared<TimingAlarmClock>();
+    auto alarmClock = adapter->add<AlarmClockPrx>(servant, {"alarmClock", clientCategory});
+
+    // The server calls the alarm clock through the server endpoint of the Glacier2 router, like the demo's server.
+    AlarmClockPrx serverAlarmClock{server.communicator(), alarmClock->ice_toString()};
+
+    // Warm up the connections.
+    serverAlarmClock->ring("warm up");
+
+    cout << "Sending " << callbackCount << " display callbacks through the Glacier2 router, oneway and batch oneway ("
+         << batchSize << " callbacks per batch)..." << endl;
+    for (int round = 0; round < 3; ++round)
+    {
+        run("oneway", serverAlarmClock, *servant, false, routerPid);
+        run("batched", serverAlarmClock, *servant, true, routerPid);
+    }
+
+    return 0;
+}
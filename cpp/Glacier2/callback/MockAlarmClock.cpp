@@ -26,6 +26,12 @@ Client::MockAlarmClock::ring(string message, const Ice::Current&)
     }
 }
 
+void
+Client::MockAlarmClock::display(string message, const Ice::Current&)
+{
+    cout << "Dispatching display request { message = '" << message << "' }" << endl;
+}
+
 void
 Client::MockAlarmClock::wait()
 {
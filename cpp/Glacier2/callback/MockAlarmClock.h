@@ -16,6 +16,9 @@ namespace Client
         // Implements the pure virtual function in the base class (AlarmClock) generated by the Slice compiler.
         EarlyRiser::ButtonPressed ring(std::string message, const Ice::Current&) override;
 
+        // Implements the pure virtual function in the base class (AlarmClock) generated by the Slice compiler.
+        void display(std::string message, const Ice::Current&) override;
+
         /// Waits until ring returns ButtonPressed::Stop. Can only be called once.
         void wait();
 
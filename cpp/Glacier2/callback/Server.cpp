@@ -1,8 +1,10 @@
 // Copyright (c) ZeroC, Inc.
 
+#include "BatchFlusher.h"
 #include "SimpleWakeUpService.h"
 
 #include <Ice/Ice.h>
+#include <chrono>
 #include <iostream>
 
 using namespace std;
@@ -20,6 +22,9 @@ main(int argc, char* argv[])
     // Make sure the communicator is destroyed at the end of this scope.
     Ice::CommunicatorHolder communicatorHolder{communicator};
 
+    // Flush the batch oneway callbacks every 50 milliseconds.
+    Server::BatchFlusher batchFlusher{communicator, 50ms};
+
     // Create an object adapter that listens for incoming requests and dispatches them to servants.
     auto adapter = communicator->createObjectAdapterWithEndpoints("WakeUpAdapter", "tcp -p 4061");
 
@@ -39,6 +39,18 @@ Server::SimpleWakeUpService::wakeMeUp(optional<AlarmClockPrx> alarmClock, int64_
         std::launch::async,
         [alarmClock = std::move(alarmClock), timePoint]()
         {
+            // Display a countdown on the alarm clock every second until the specified time point. The reminders are
+            // batch oneway requests: the batch flusher sends all the reminders queued for the Glacier2 router, for all
+            // the alarm clocks, in a single message.
+            auto reminders = alarmClock->ice_batchOneway();
+            for (auto remaining = chrono::duration_cast<chrono::seconds>(timePoint - chrono::system_clock::now());
+                 remaining >= 1s;
+                 remaining -= 1s)
+            {
+                reminders->display("Alarm rings in " + to_string(remaining.count()) + " s");
+                this_thread::sleep_until(timePoint - remaining + 1s);
+            }
+
             // Sleep until the specified time point.
             this_thread::sleep_until(timePoint);
 
@@ -0,0 +1,48 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "Greeter.h"
+#include "SessionPool.h"
+
+#include <Glacier2/Glacier2.h>
+#include <Ice/Ice.h>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int
+main(int argc, char* argv[])
+{
+    // Create an Ice communicator. We'll use this communicator to create proxies and manage outgoing connections.
+    Ice::CommunicatorPtr communicator = Ice::initialize(argc, argv);
+
+    // Make sure the communicator is destroyed at the end of this scope.
+    Ice::CommunicatorHolder communicatorHolder{communicator};
+
+    Glacier2::RouterPrx router{communicator, "Glacier2/router:tcp -h localhost -p 4063"};
+    VisitorCenter::GreeterPrx greeter{communicator, "greeter:tcp -h localhost -p 4061"};
+
+    // A gateway acts on behalf of many users. Instead of creating one Glacier2 session (and one connection) per user,
+    // it multiplexes the requests of all its users over a small pool of sessions.
+    Client::SessionPool sessionPool{router, "gateway", "password", 2};
+
+    // Send a greet request on behalf of each user, concurrently.
+    vector<string> users{"alice", "bob", "carol", "dave", "erin", "frank", "grace", "heidi"};
+    vector<future<string>> futures;
+    futures.reserve(users.size());
+    for (const string& user : users)
+    {
+        futures.push_back(sessionPool.route(greeter, user)->greetAsync(user));
+    }
+
+    for (auto& greeting : futures)
+    {
+        cout << greeting.get() << endl;
+    }
+
+    cout << users.size() << " users sent their requests through " << sessionPool.size()
+         << " Glacier2 sessions." << endl;
+    return 0;
+}
@@ -0,0 +1,209 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "Greeter.h"
+
+#include <Glacier2/Glacier2.h>
+#include <Ice/Ice.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    /// The maximum number of session creations or greet requests in flight.
+    constexpr size_t window = 200;
+
+    /// The number of greet requests sent by each session.
+    constexpr int requestsPerSession = 10;
+
+    /// Reads the resident memory of a process, on Linux.
+    /// @param pid The process ID.
+    /// @return The resident memory in kilobytes, or nullopt if it's not available.
+    optional<long> readResidentKb(const string& pid)
+    {
+        ifstream status{"/proc/" + pid + "/status"};
+        string line;
+        while (getline(status, line))
+        {
+            istringstream is{line};
+            string field;
+            long value = 0;
+            if (is >> field >> value && field == "VmRSS:")
+            {
+                return value;
+            }
+        }
+        return nullopt;
+    }
+
+    /// Sends requestsPerSession greet requests with each proxy, with at most window requests in flight, and returns
+    /// the latency of each request.
+    vector<chrono::microseconds> sendGreetings(const vector<VisitorCenter::GreeterPrx>& greeters)
+    {
+        vector<chrono::microseconds> latencies;
+        latencies.reserve(greeters.size() * requestsPerSession);
+
+        // The reply callbacks measure the latency when the reply arrives, and release the request's place in the
+        // window.
+        mutex windowMutex;
+        condition_variable windowCondition;
+        size_t inFlight = 0;
+        exception_ptr failure;
+
+        auto complete = [&](chrono::steady_clock::time_point start, exception_ptr ex)
+        {
+            auto latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+            const lock_guard<mutex> lock(windowMutex);
+            if (ex)
+            {
+                failure = failure ? failure : ex;
+            }
+            else
+            {
+                latencies.push_back(latency);
+            }
+            --inFlight;
+
+            // Notify with the mutex locked: the last notification can otherwise reach a condition variable that
+            // sendGreetings already destroyed.
+            windowCondition.notify_one();
+        };
+
+        for (int round = 0; round < requestsPerSession; ++round)
+        {
+            for (size_t i = 0; i < greeters.size(); ++i)
+            {
+                {
+                    unique_lock<mutex> lock(windowMutex);
+                    windowCondition.wait(lock, [&] { return inFlight < window; });
+                    ++inFlight;
+                }
+
+                auto start = chrono::steady_clock::now();
+                greeters[i]->greetAsync(
+                    "user-" + to_string(i),
+                    [complete, start](const string&) { complete(start, nullptr); },
+                    [complete, start](exception_ptr ex) { complete(start, ex); });
+            }
+        }
+
+        unique_lock<mutex> lock(windowMutex);
+        windowCondition.wait(lock, [&] { return inFlight == 0; });
+        if (failure)
+        {
+            rethrow_exception(failure);
+        }
+        return latencies;
+    }
+
+    void printLatencies(const char* label, vector<chrono::microseconds> latencies, chrono::duration<double> elapsed)
+    {
+        sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p)
+        { return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))].count(); };
+
+        cout << "  " << left << setw(8) << label << right << fixed << setprecision(0) << setw(9)
+             << static_cast<double>(latencies.size()) / elapsed.count() << " req/s" << setw(8) << percentile(0.5)
+             << " us p50" << setw(8) << percentile(0.99) << " us p99" << endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    Ice::CommunicatorHolder communicator{Ice::initialize(argc, argv)};
+
+    // The first argument is the number of sessions, and the optional second argument is the process ID of the
+    // Glacier2 router: on Linux, the load test reports the memory of the router.
+    size_t sessionCount = argc > 1 ? static_cast<size_t>(max(1L, atol(argv[1]))) : 1000;
+    string routerPid = argc > 2 ? argv[2] : "";
+
+    Glacier2::RouterPrx router{communicator.communicator(), "Glacier2/router:tcp -h localhost -p 4063"};
+    VisitorCenter::GreeterPrx greeter{communicator.communicator(), "greeter:tcp -h localhost -p 4061"};
+
+    optional<long> routerKbBefore = readResidentKb(routerPid);
+
+    // A Glacier2 session lives as long as its connection to the router. Each session uses its own connection ID, and
+    // therefore its own connection, on the same communicator.
+    cout << "Creating " << sessionCount << " Glacier2 sessions..." << endl;
+    vector<VisitorCenter::GreeterPrx> routedGreeters;
+    routedGreeters.reserve(sessionCount);
+    size_t failed = 0;
+
+    auto start = chrono::steady_clock::now();
+    vector<future<optional<Glacier2::SessionPrx>>> pending;
+    for (size_t i = 0; i < sessionCount; ++i)
+    {
+        string connectionId = "session-" + to_string(i);
+        Glacier2::RouterPrx sessionRouter = router->ice_connectionId(connectionId);
+        pending.push_back(sessionRouter->createSessionAsync("user-" + to_string(i), "password"));
+
+        // The routed proxy must use the same connection ID as the session's router proxy, to reuse its connection.
+        routedGreeters.push_back(greeter->ice_router(sessionRouter)->ice_connectionId(connectionId));
+
+        if (pending.size() == window || i + 1 == sessionCount)
+        {
+            for (auto& session : pending)
+            {
+                try
+                {
+                    session.get();
+                }
+                catch (const std::exception& ex)
+                {
+                    if (failed++ == 0)
+                    {
+                        cout << "Session creation failed: " << ex.what() << endl;
+                    }
+                }
+            }
+            pending.clear();
+        }
+    }
+    chrono::duration<double> setupTime = chrono::steady_clock::now() - start;
+
+    cout << "  " << sessionCount - failed << " sessions in " << fixed << setprecision(2) << setupTime.count()
+         << " s: " << setprecision(0) << static_cast<double>(sessionCount - failed) / setupTime.count()
+         << " sessions/s (" << failed << " failed)" << endl;
+
+    optional<long> routerKbAfter = readResidentKb(routerPid);
+    if (routerKbBefore && routerKbAfter && sessionCount > failed)
+    {
+        cout << "  router memory: " << *routerKbAfter / 1024 << " MB, " << setprecision(1)
+             << static_cast<double>(*routerKbAfter - *routerKbBefore) / static_cast<double>(sessionCount - failed)
+             << " KB per session" << endl;
+    }
+
+    if (failed > 0)
+    {
+        cout << "Skipping the greet requests since some sessions failed." << endl;
+        return 1;
+    }
+
+    // Compare the latency of greet requests sent through the router, over all the sessions, with the latency of the
+    // same requests sent directly to the server.
+    cout << endl << "Sending " << requestsPerSession << " greet requests per session..." << endl;
+
+    start = chrono::steady_clock::now();
+    vector<chrono::microseconds> routedLatencies = sendGreetings(routedGreeters);
+    printLatencies("routed", std::move(routedLatencies), chrono::steady_clock::now() - start);
+
+    start = chrono::steady_clock::now();
+    vector<chrono::microseconds> directLatencies =
+        sendGreetings(vector<VisitorCenter::GreeterPrx>(sessionCount, greeter));
+    printLatencies("direct", std::move(directLatencies), chrono::steady_clock::now() - start);
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "SessionPool.h"
+
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+Client::SessionPool::SessionPool(const Glacier2::RouterPrx& router, string userId, string password, size_t size)
+    : _userId{std::move(userId)},
+      _password{std::move(password)}
+{
+    if (size == 0)
+    {
+        throw invalid_argument{"a session pool needs at least one session"};
+    }
+
+    _slots.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        // Each session uses its own connection ID and therefore its own connection to the router.
+        _slots.push_back(make_shared<Slot>(router->ice_connectionId("gateway-" + to_string(i))));
+    }
+}
+
+const Glacier2::RouterPrx&
+Client::SessionPool::connect(const string& user)
+{
+    const shared_ptr<Slot>& slotPtr = _slots[hash<string>{}(user) % _slots.size()];
+    Slot& slot = *slotPtr;
+
+    Ice::ConnectionPtr connection;
+    {
+        const lock_guard<mutex> lock(slot.mutex);
+        if (slot.active)
+        {
+            return slot.router;
+        }
+
+        // Creating the session establishes a new connection to the router, since the previous connection (if any)
+        // was closed. We don't configure a SessionManager on the router, so the returned session proxy is null.
+        slot.router->createSession(_userId, _password);
+        connection = slot.router->ice_getCachedConnection();
+        slot.active = true;
+    }
+
+    // The session lives as long as its connection. Install the close callback outside the lock: it's called
+    // immediately if the connection is already closed.
+    connection->setCloseCallback(
+        [weakSlot = weak_ptr<Slot>{slotPtr}](const Ice::ConnectionPtr&)
+        {
+            if (auto closedSlot = weakSlot.lock())
+            {
+                const lock_guard<mutex> lock(closedSlot->mutex);
+                closedSlot->active = false;
+            }
+        });
+
+    return slot.router;
+}
@@ -0,0 +1,67 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef SESSION_POOL_H
+#define SESSION_POOL_H
+
+#include <Glacier2/Glacier2.h>
+#include <Ice/Ice.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Client
+{
+    /// SessionPool multiplexes the requests of many logical users over a small pool of Glacier2 sessions.
+    /// A Glacier2 session is bound to a connection, so a gateway that creates one session per user needs one connection
+    /// (and one TLS handshake) per user. SessionPool instead creates a few sessions, each with its own connection
+    /// ID, and always sends the requests of a given user over the same session. The user is sent to the server in the
+    /// request context.
+    class SessionPool
+    {
+    public:
+        /// Constructs a session pool. The sessions are created on demand.
+        /// @param router The proxy to the Glacier2 router.
+        /// @param userId The user ID used to create the gateway's sessions.
+        /// @param password The password used to create the gateway's sessions.
+        /// @param size The number of sessions in the pool.
+        SessionPool(const Glacier2::RouterPrx& router, std::string userId, std::string password, std::size_t size);
+
+        /// Gets a proxy that sends requests on behalf of a user through the Glacier2 router. The session used for this
+        /// user is created if needed: this function makes a synchronous invocation when the session's connection was
+        /// closed. Call route again after a ConnectionLostException or CloseConnectionException to reconnect.
+        /// @param proxy The proxy to route.
+        /// @param user The user. All the requests of a user go through the same session and are dispatched in order.
+        /// @return A proxy configured with the session's router and connection ID, and with a "user" context.
+        template<typename Prx> Prx route(const Prx& proxy, const std::string& user)
+        {
+            const Glacier2::RouterPrx& router = connect(user);
+            return proxy->ice_router(router)->ice_connectionId(router->ice_getConnectionId())->ice_context(
+                Ice::Context{{"user", user}});
+        }
+
+        /// Gets the number of sessions in the pool.
+        /// @return The number of sessions.
+        [[nodiscard]] std::size_t size() const noexcept { return _slots.size(); }
+
+    private:
+        struct Slot
+        {
+            explicit Slot(Glacier2::RouterPrx r) : router{std::move(r)} {}
+
+            std::mutex mutex;
+            const Glacier2::RouterPrx router;
+            bool active{false};
+        };
+
+        // Returns the router proxy of the user's session, after creating this session if needed.
+        const Glacier2::RouterPrx& connect(const std::string& user);
+
+        const std::string _userId;
+        const std::string _password;
+        std::vector<std::shared_ptr<Slot>> _slots;
+    };
+}
+
+#endif
@@ -3,23 +3,56 @@
 #include "BidirWakeUpService.h"
 #include "../../common/Time.h"
 
-#include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <thread>
 
 using namespace EarlyRiser;
 using namespace std;
 
-Server::BidirWakeUpService::~BidirWakeUpService()
+namespace
 {
-    // Waits for all outstanding tasks to complete.
-    for (const auto& task : _tasks)
+    // Rings an alarm clock with ringAsync. When the user presses the snooze button, the alarm clock rings again 10
+    // seconds later. The callbacks only keep a weak pointer to the timer wheel, since the wheel holds the callbacks
+    // that call ring.
+    void ring(const weak_ptr<Server::TimerWheel>& timerWheel, const AlarmClockPrx& alarmClock, const string& message)
     {
-        task.wait();
+        // The reply is delivered to a thread from the Ice client thread pool.
+        alarmClock->ringAsync(
+            message,
+            [timerWheel, alarmClock](ButtonPressed buttonPressed)
+            {
+                if (buttonPressed == ButtonPressed::Snooze)
+                {
+                    if (auto wheel = timerWheel.lock())
+                    {
+                        wheel->schedule(
+                            chrono::system_clock::now() + 10s,
+                            [timerWheel, alarmClock] { ring(timerWheel, alarmClock, "No more snoozing!"); });
+                    }
+                }
+            },
+            [alarmClock](exception_ptr exceptionPtr)
+            {
+                try
+                {
+                    rethrow_exception(exceptionPtr);
+                }
+                catch (const Ice::CommunicatorDestroyedException&)
+                {
+                    // The server is shutting down.
+                }
+                catch (const std::exception& ex)
+                {
+                    cout << "Failed to ring alarm clock '" << alarmClock << "': " << ex.what() << endl;
+                }
+            });
     }
 }
 
+Server::BidirWakeUpService::BidirWakeUpService(shared_ptr<ConnectionRegistry> registry) : _registry{std::move(registry)}
+{
+}
+
 void
 Server::BidirWakeUpService::wakeMeUp(int64_t timeStamp, const Ice::Current& current)
 {
@@ -34,33 +67,14 @@ Server::BidirWakeUpService::wakeMeUp(int64_t timeStamp, const Ice::Current& curr
         throw std::invalid_argument{"BidirWakeUpService does not support collocated calls"};
     }
 
-    // Create a proxy to the client's alarm clock. This connection-bound proxy is called a "fixed proxy".
-    auto alarmClock = connection->createProxy<AlarmClockPrx>(Ice::Identity{"alarmClock"});
-
-    // Schedule a wake-up call in a background task.
-    _tasks.emplace_back(std::async(
-        std::launch::async,
-        [alarmClock = std::move(alarmClock), timePoint]()
-        {
-            // Sleep until the specified time point.
-            this_thread::sleep_until(timePoint);
-
-            // First ring.
-            ButtonPressed buttonPressed = alarmClock->ring("It's time to wake up!");
-
-            // Keep ringing every 10 seconds until the user presses the stop button.
-            while (buttonPressed == ButtonPressed::Snooze)
-            {
-                this_thread::sleep_for(10s);
-                buttonPressed = alarmClock->ring("No more snoozing!");
-            }
-        }));
+    // Register the client connection, and get a fixed proxy to the client's alarm clock. The client can join a group
+    // with the "group" entry of the request context.
+    auto p = current.ctx.find("group");
+    AlarmClockPrx alarmClock = _registry->add(connection, p != current.ctx.end() ? p->second : "");
 
-    // We don't want the _tasks vector to grow forever so remove all completed tasks here, without waiting.
-    _tasks.erase(
-        std::remove_if(
-            _tasks.begin(),
-            _tasks.end(),
-            [](const auto& task) { return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }),
-        _tasks.end());
+    // Schedule a wake-up call. The timer wheel calls ring from its own thread at the specified time point.
+    _timerWheel->schedule(
+        timePoint,
+        [timerWheel = weak_ptr<TimerWheel>{_timerWheel}, alarmClock = std::move(alarmClock)]
+        { ring(timerWheel, alarmClock, "It's time to wake up!"); });
 }
@@ -4,9 +4,10 @@
 #define BIDIR_WAKE_UP_SERVICE_H
 
 #include "AlarmClock.h"
+#include "ConnectionRegistry.h"
+#include "TimerWheel.h"
 
-#include <future>
-#include <vector>
+#include <memory>
 
 namespace Server
 {
@@ -14,14 +15,19 @@ namespace Server
     class BidirWakeUpService : public EarlyRiser::WakeUpService
     {
     public:
-        // Waits for all outstanding tasks to complete.
-        ~BidirWakeUpService() override;
+        /// Constructs a BidirWakeUpService servant.
+        /// @param registry The registry of the client connections.
+        explicit BidirWakeUpService(std::shared_ptr<ConnectionRegistry> registry);
 
         // Implements the pure virtual function in the base class (WakeUpService) generated by the Slice compiler.
         void wakeMeUp(std::int64_t timeStamp, const Ice::Current&) override;
 
     private:
-        std::vector<std::future<void>> _tasks;
+        const std::shared_ptr<ConnectionRegistry> _registry;
+
+        // All the wake-up calls share the thread of this timer wheel, and ring the alarm clocks with ringAsync. The
+        // destruction of the servant stops the wheel; the wake-up calls that are not due yet are dropped.
+        const std::shared_ptr<TimerWheel> _timerWheel = std::make_shared<TimerWheel>();
     };
 }
 
@@ -0,0 +1,183 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ConnectionRegistry.h"
+
+using namespace EarlyRiser;
+using namespace std;
+
+namespace
+{
+    /// The state of a broadcast or multicast ring, shared by the ringAsync callbacks.
+    struct FanOut
+    {
+        vector<AlarmClockPrx> alarmClocks;
+        string message;
+        size_t maxInFlight;
+
+        mutex stateMutex;
+        size_t next{0};
+        size_t inFlight{0};
+        Server::BroadcastResult result;
+        promise<Server::BroadcastResult> completion;
+    };
+
+    void sendRings(const shared_ptr<FanOut>& fanOut);
+
+    // Records the outcome of a ring, and sends the next rings.
+    void completed(const shared_ptr<FanOut>& fanOut, optional<ButtonPressed> buttonPressed)
+    {
+        bool done = false;
+        {
+            const lock_guard<mutex> lock(fanOut->stateMutex);
+            if (!buttonPressed)
+            {
+                ++fanOut->result.failed;
+            }
+            else if (*buttonPressed == ButtonPressed::Snooze)
+            {
+                ++fanOut->result.snoozed;
+            }
+            else
+            {
+                ++fanOut->result.stopped;
+            }
+            --fanOut->inFlight;
+            done = fanOut->inFlight == 0 && fanOut->next == fanOut->alarmClocks.size();
+        }
+
+        if (done)
+        {
+            fanOut->completion.set_value(fanOut->result);
+        }
+        else
+        {
+            sendRings(fanOut);
+        }
+    }
+
+    // Sends rings until maxInFlight rings are in flight, or until all the alarm clocks got a ring.
+    void sendRings(const shared_ptr<FanOut>& fanOut)
+    {
+        vector<AlarmClockPrx> batch;
+        {
+            const lock_guard<mutex> lock(fanOut->stateMutex);
+            while (fanOut->inFlight < fanOut->maxInFlight && fanOut->next < fanOut->alarmClocks.size())
+            {
+                batch.push_back(fanOut->alarmClocks[fanOut->next++]);
+                ++fanOut->inFlight;
+            }
+        }
+
+        for (const auto& alarmClock : batch)
+        {
+            // The reply is delivered to a thread from the Ice client thread pool.
+            alarmClock->ringAsync(
+                fanOut->message,
+                [fanOut](ButtonPressed buttonPressed) { completed(fanOut, buttonPressed); },
+                [fanOut](exception_ptr) { completed(fanOut, nullopt); });
+        }
+    }
+}
+
+Server::ConnectionRegistry::ConnectionRegistry(size_t maxInFlight) : _maxInFlight{maxInFlight} {}
+
+AlarmClockPrx
+Server::ConnectionRegistry::add(const Ice::ConnectionPtr& connection, string group)
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        auto p = _clients.find(connection.get());
+        if (p != _clients.end())
+        {
+            p->second.group = std::move(group);
+            return p->second.alarmClock;
+        }
+    }
+
+    // Create a proxy to the client's alarm clock. This connection-bound proxy is called a "fixed proxy".
+    auto alarmClock = connection->createProxy<AlarmClockPrx>(Ice::Identity{"alarmClock"});
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _clients.emplace(connection.get(), Client{alarmClock, std::move(group)});
+    }
+
+    // Remove the client when its connection closes. We install the close callback outside the lock: if the connection
+    // is already closed, Ice calls the callback right away.
+    connection->setCloseCallback(
+        [weakSelf = weak_from_this()](const Ice::ConnectionPtr& closedConnection)
+        {
+            if (auto self = weakSelf.lock())
+            {
+                self->remove(closedConnection.get());
+            }
+        });
+
+    return alarmClock;
+}
+
+size_t
+Server::ConnectionRegistry::size() const
+{
+    const lock_guard<mutex> lock(_mutex);
+    return _clients.size();
+}
+
+future<Server::BroadcastResult>
+Server::ConnectionRegistry::broadcast(string message)
+{
+    vector<AlarmClockPrx> alarmClocks;
+    {
+        const lock_guard<mutex> lock(_mutex);
+        alarmClocks.reserve(_clients.size());
+        for (const auto& [connection, client] : _clients)
+        {
+            alarmClocks.push_back(client.alarmClock);
+        }
+    }
+    return ring(std::move(alarmClocks), std::move(message));
+}
+
+future<Server::BroadcastResult>
+Server::ConnectionRegistry::multicast(const string& group, string message)
+{
+    vector<AlarmClockPrx> alarmClocks;
+    {
+        const lock_guard<mutex> lock(_mutex);
+        for (const auto& [connection, client] : _clients)
+        {
+            if (client.group == group)
+            {
+                alarmClocks.push_back(client.alarmClock);
+            }
+        }
+    }
+    return ring(std::move(alarmClocks), std::move(message));
+}
+
+future<Server::BroadcastResult>
+Server::ConnectionRegistry::ring(vector<AlarmClockPrx> alarmClocks, string message)
+{
+    auto fanOut = make_shared<FanOut>();
+    fanOut->alarmClocks = std::move(alarmClocks);
+    fanOut->message = std::move(message);
+    fanOut->maxInFlight = _maxInFlight;
+    fanOut->result.clients = fanOut->alarmClocks.size();
+
+    future<BroadcastResult> result = fanOut->completion.get_future();
+    if (fanOut->alarmClocks.empty())
+    {
+        fanOut->completion.set_value(fanOut->result);
+    }
+    else
+    {
+        sendRings(fanOut);
+    }
+    return result;
+}
+
+void
+Server::ConnectionRegistry::remove(const Ice::Connection* connection)
+{
+    const lock_guard<mutex> lock(_mutex);
+    _clients.erase(connection);
+}
@@ -0,0 +1,82 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef CONNECTION_REGISTRY_H
+#define CONNECTION_REGISTRY_H
+
+#include "AlarmClock.h"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Server
+{
+    /// The outcome of a broadcast or multicast ring.
+    struct BroadcastResult
+    {
+        /// The number of alarm clocks that rang.
+        size_t clients{0};
+
+        /// The number of alarm clocks where the user pressed the snooze button.
+        size_t snoozed{0};
+
+        /// The number of alarm clocks where the user pressed the stop button.
+        size_t stopped{0};
+
+        /// The number of alarm clocks we could not reach.
+        size_t failed{0};
+    };
+
+    /// ConnectionRegistry tracks the connections of the clients, together with the alarm clock each client hosts on its
+    /// connection. A client leaves the registry when its connection closes.
+    /// The registry can ring all the alarm clocks (broadcast) or the alarm clocks of a group of clients (multicast). It
+    /// rings with ringAsync and a bounded number of rings in flight, without using any thread of its own.
+    class ConnectionRegistry final : public std::enable_shared_from_this<ConnectionRegistry>
+    {
+    public:
+        /// Constructs a ConnectionRegistry.
+        /// @param maxInFlight The maximum number of ring requests of a broadcast waiting for a reply.
+        explicit ConnectionRegistry(size_t maxInFlight = 1000);
+
+        /// Adds a client connection to the registry, or updates its group if the connection is already registered.
+        /// @param connection The connection from the client to the server.
+        /// @param group The group of the client.
+        /// @return A fixed proxy to the alarm clock hosted by the client on this connection.
+        EarlyRiser::AlarmClockPrx add(const Ice::ConnectionPtr& connection, std::string group);
+
+        /// Gets the number of registered clients.
+        /// @return The number of registered clients.
+        size_t size() const;
+
+        /// Rings the alarm clocks of all the registered clients.
+        /// @param message The message to display.
+        /// @return A future that completes once all the alarm clocks replied or failed.
+        std::future<BroadcastResult> broadcast(std::string message);
+
+        /// Rings the alarm clocks of the registered clients in a group.
+        /// @param group The group.
+        /// @param message The message to display.
+        /// @return A future that completes once all the alarm clocks of the group replied or failed.
+        std::future<BroadcastResult> multicast(const std::string& group, std::string message);
+
+    private:
+        struct Client
+        {
+            EarlyRiser::AlarmClockPrx alarmClock;
+            std::string group;
+        };
+
+        std::future<BroadcastResult> ring(std::vector<EarlyRiser::AlarmClockPrx> alarmClocks, std::string message);
+        void remove(const Ice::Connection* connection);
+
+        const size_t _maxInFlight;
+
+        mutable std::mutex _mutex;
+        std::unordered_map<const Ice::Connection*, Client> _clients;
+    };
+}
+
+#endif
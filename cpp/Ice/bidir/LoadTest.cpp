@@ -0,0 +1,338 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "../../common/Time.h"
+#include "AlarmClock.h"
+#include "BidirWakeUpService.h"
+#include "ConnectionRegistry.h"
+
+#include <Ice/Ice.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace EarlyRiser;
+using namespace std;
+
+namespace
+{
+    /// The resource usage of a process.
+    struct ResourceUsage
+    {
+        long residentKb{0};
+        long threads{0};
+        long fileDescriptors{0};
+    };
+
+    /// Samples the resource usage of the calling process. Uses /proc on Linux; elsewhere, reports the peak resident
+    /// size and no thread count.
+    ResourceUsage sampleResourceUsage()
+    {
+        ResourceUsage usage;
+
+        ifstream status{"/proc/self/status"};
+        if (status)
+        {
+            string line;
+            while (getline(status, line))
+            {
+                istringstream is{line};
+                string field;
+                is >> field;
+                if (field == "VmRSS:")
+                {
+                    is >> usage.residentKb;
+                }
+                else if (field == "Threads:")
+                {
+                    is >> usage.threads;
+                }
+            }
+        }
+        else
+        {
+            rusage resources{};
+            getrusage(RUSAGE_SELF, &resources);
+#ifdef __APPLE__
+            usage.residentKb = resources.ru_maxrss / 1024; // in bytes on macOS
+#else
+            usage.residentKb = resources.ru_maxrss;
+#endif
+        }
+
+        const filesystem::path fdDirectory = filesystem::exists("/proc/self/fd") ? "/proc/self/fd" : "/dev/fd";
+        for ([[maybe_unused]] const auto& entry : filesystem::directory_iterator{fdDirectory})
+        {
+            ++usage.fileDescriptors;
+        }
+        return usage;
+    }
+
+    // The load server and the load client talk over a pair of pipes, one line per message.
+    void writeLine(int fd, const string& line)
+    {
+        string data = line + "\n";
+        const char* p = data.data();
+        size_t remaining = data.size();
+        while (remaining > 0)
+        {
+            ssize_t written = ::write(fd, p, remaining);
+            if (written <= 0)
+            {
+                throw runtime_error{"cannot write to pipe"};
+            }
+            p += written;
+            remaining -= static_cast<size_t>(written);
+        }
+    }
+
+    string readLine(int fd)
+    {
+        string line;
+        char c = 0;
+        while (::read(fd, &c, 1) == 1 && c != '\n')
+        {
+            line += c;
+        }
+        return line;
+    }
+
+    /// Runs the load server, in a child process: reads commands from commandFd and writes replies to replyFd.
+    int runServer(int argc, char* argv[], int commandFd, int replyFd, size_t clients)
+    {
+        // BidirWakeUpService logs each wakeMeUp request: we discard the standard output of the load server.
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0)
+        {
+            dup2(devNull, STDOUT_FILENO);
+            close(devNull);
+        }
+
+        Ice::InitializationData initData;
+        initData.properties = Ice::createProperties(argc, argv);
+        Ice::CommunicatorHolder communicator{Ice::initialize(initData)};
+
+        // Each listening endpoint accepts at most about 28,000 connections from the same client address on Linux (the
+        // default range of ephemeral ports), so we listen on one port per 20,000 clients.
+        string endpoints;
+        for (size_t i = 0; i <= clients / 20000; ++i)
+        {
+            endpoints += (i == 0 ? "" : ":") + string{"tcp -h localhost -p 0"};
+        }
+        auto adapter = communicator->createObjectAdapterWithEndpoints("LoadAdapter", endpoints);
+
+        auto registry = make_shared<Server::ConnectionRegistry>();
+        auto wakeUpService =
+            adapter->add(make_shared<Server::BidirWakeUpService>(registry), Ice::Identity{"wakeUpService"});
+        adapter->activate();
+
+        ResourceUsage baseline = sampleResourceUsage();
+        writeLine(replyFd, wakeUpService->ice_toString());
+
+        for (string command = readLine(commandFd); command == "stats" || command == "broadcast";
+             command = readLine(commandFd))
+        {
+            ostringstream os;
+            if (command == "stats")
+            {
+                ResourceUsage usage = sampleResourceUsage();
+                os << registry->size() << " " << baseline.residentKb << " " << usage.residentKb << " "
+                   << usage.threads << " " << usage.fileDescriptors - baseline.fileDescriptors;
+            }
+            else
+            {
+                auto start = chrono::steady_clock::now();
+                Server::BroadcastResult result = registry->broadcast("Load test").get();
+                auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+                os << result.clients << " " << result.failed << " " << elapsed.count();
+            }
+            writeLine(replyFd, os.str());
+        }
+        return 0;
+    }
+
+    /// CountingAlarmClock records the arrival time of each ring, and always presses the stop button.
+    class CountingAlarmClock : public AlarmClock
+    {
+    public:
+        ButtonPressed ring(string, const Ice::Current&) final
+        {
+            auto now = chrono::steady_clock::now();
+            const lock_guard<mutex> lock(_mutex);
+            _arrivals.push_back(now);
+            return ButtonPressed::Stop;
+        }
+
+        vector<chrono::steady_clock::time_point> takeArrivals()
+        {
+            const lock_guard<mutex> lock(_mutex);
+            return std::move(_arrivals);
+        }
+
+    private:
+        mutex _mutex;
+        vector<chrono::steady_clock::time_point> _arrivals;
+    };
+
+    /// Runs the load client, in the parent process.
+    int runClient(int argc, char* argv[], int commandFd, int replyFd, size_t clients)
+    {
+        // The client dispatches the rings with up to 4 threads.
+        Ice::InitializationData initData;
+        initData.properties = Ice::createProperties(argc, argv);
+        initData.properties->setProperty("Ice.ThreadPool.Client.SizeMax", "4");
+        Ice::CommunicatorHolder communicator{Ice::initialize(initData)};
+
+        // All the client connections dispatch the rings to the same alarm clock, through the default object adapter.
+        Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("");
+        communicator->setDefaultObjectAdapter(adapter);
+        auto alarmClock = make_shared<CountingAlarmClock>();
+        adapter->add(alarmClock, Ice::Identity{"alarmClock"});
+
+        WakeUpServicePrx wakeUpService{communicator.communicator(), readLine(replyFd)};
+        Ice::EndpointSeq endpoints = wakeUpService->ice_getEndpoints();
+
+        cout << "Opening " << clients << " client connections..." << endl;
+
+        // Each connection ID gives a separate connection. We keep up to 1,000 registrations in flight. The wake-up
+        // calls are due in one hour, after the end of the test: they stay scheduled in the server's timer wheel.
+        int64_t timeStamp = Time::toTimeStamp(chrono::system_clock::now() + 1h);
+        auto start = chrono::steady_clock::now();
+        size_t failed = 0;
+        vector<future<void>> pending;
+        for (size_t i = 0; i < clients; ++i)
+        {
+            WakeUpServicePrx client = wakeUpService->ice_connectionId("client-" + to_string(i))
+                                          ->ice_endpoints({endpoints[i % endpoints.size()]});
+            pending.push_back(client->wakeMeUpAsync(timeStamp));
+            if (pending.size() == 1000 || i + 1 == clients)
+            {
+                for (auto& registration : pending)
+                {
+                    try
+                    {
+                        registration.get();
+                    }
+                    catch (const Ice::LocalException& ex)
+                    {
+                        if (failed++ == 0)
+                        {
+                            cout << "Registration failed: " << ex.what() << endl;
+                        }
+                    }
+                }
+                pending.clear();
+            }
+        }
+        chrono::duration<double> connectTime = chrono::steady_clock::now() - start;
+        cout << "Opened " << clients - failed << " connections in " << fixed << setprecision(1) << connectTime.count()
+             << " s (" << failed << " failed)" << endl;
+
+        writeLine(commandFd, "stats");
+        {
+            istringstream is{readLine(replyFd)};
+            size_t registered = 0;
+            long baselineKb = 0, residentKb = 0, threads = 0, fileDescriptors = 0;
+            is >> registered >> baselineKb >> residentKb >> threads >> fileDescriptors;
+
+            cout << endl << "Server with " << registered << " registered clients and scheduled wake-up calls:" << endl;
+            cout << "  resident memory: " << residentKb / 1024 << " MB (" << baselineKb / 1024 << " MB at startup)"
+                 << endl;
+            if (registered > 0)
+            {
+                cout << "  memory per connection: " << setprecision(2)
+                     << static_cast<double>(residentKb - baselineKb) / static_cast<double>(registered) << " KB" << endl;
+                cout << "  file descriptors per connection: "
+                     << static_cast<double>(fileDescriptors) / static_cast<double>(registered) << endl;
+            }
+            cout << "  threads: " << (threads > 0 ? to_string(threads) : "n/a") << endl;
+        }
+
+        // Broadcast a few times, and measure when each ring reaches the client.
+        cout << endl << "Broadcasting rings to all the clients..." << endl;
+        for (int round = 0; round < 3; ++round)
+        {
+            auto broadcastStart = chrono::steady_clock::now();
+            writeLine(commandFd, "broadcast");
+
+            istringstream is{readLine(replyFd)};
+            size_t rung = 0, ringFailed = 0;
+            long long serverMicros = 0;
+            is >> rung >> ringFailed >> serverMicros;
+
+            vector<chrono::steady_clock::time_point> arrivals = alarmClock->takeArrivals();
+            vector<chrono::microseconds> latencies;
+            latencies.reserve(arrivals.size());
+            for (auto arrival : arrivals)
+            {
+                latencies.push_back(chrono::duration_cast<chrono::microseconds>(arrival - broadcastStart));
+            }
+            sort(latencies.begin(), latencies.end());
+            auto percentile = [&latencies](double p)
+            {
+                return latencies.empty()
+                           ? 0
+                           : latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))].count();
+            };
+
+            cout << "  round " << round + 1 << ": " << rung << " rings (" << ringFailed << " failed), all replies in "
+                 << serverMicros / 1000 << " ms; arrival p50 " << percentile(0.5) / 1000 << " ms, p99 "
+                 << percentile(0.99) / 1000 << " ms, max " << percentile(1.0) / 1000 << " ms" << endl;
+        }
+
+        writeLine(commandFd, "exit");
+        return 0;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    // The first argument is the number of client connections.
+    size_t clients = 10000;
+    if (argc > 1 && argv[1][0] != '-')
+    {
+        clients = static_cast<size_t>(max(1L, atol(argv[1])));
+    }
+
+    // The load server runs in a child process, so that its resource usage doesn't include the client connections. We
+    // fork before creating any communicator or thread.
+    int commandPipe[2];
+    int replyPipe[2];
+    if (pipe(commandPipe) != 0 || pipe(replyPipe) != 0)
+    {
+        cerr << "cannot create pipes" << endl;
+        return 1;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        cerr << "cannot fork" << endl;
+        return 1;
+    }
+
+    if (pid == 0)
+    {
+        close(commandPipe[1]);
+        close(replyPipe[0]);
+        return runServer(argc, argv, commandPipe[0], replyPipe[1], clients);
+    }
+
+    close(commandPipe[0]);
+    close(replyPipe[1]);
+    int status = runClient(argc, argv, commandPipe[1], replyPipe[0], clients);
+    waitpid(pid, nullptr, 0);
+    return status;
+}
@@ -1,8 +1,10 @@
 // Copyright (c) ZeroC, Inc.
 
 #include "BidirWakeUpService.h"
+#include "ConnectionRegistry.h"
 
 #include <Ice/Ice.h>
+#include <chrono>
 #include <iostream>
 
 using namespace std;
@@ -22,8 +24,11 @@ main(int argc, char* argv[])
     // Create an object adapter that listens for incoming requests and dispatches them to servants.
     auto adapter = communicator->createObjectAdapterWithEndpoints("WakeUpAdapter", "tcp -p 4061");
 
+    // Create the registry of the client connections.
+    auto registry = make_shared<Server::ConnectionRegistry>();
+
     // Register the BidirWakeUpService servant with the adapter.
-    adapter->add(make_shared<Server::BidirWakeUpService>(), Ice::Identity{"wakeUpService"});
+    adapter->add(make_shared<Server::BidirWakeUpService>(registry), Ice::Identity{"wakeUpService"});
 
     // Start dispatching requests.
     adapter->activate();
@@ -31,9 +36,20 @@ main(int argc, char* argv[])
 
     // Shut down the communicator when the user presses Ctrl+C.
     ctrlCHandler.setCallback(
-        [communicator](int signal)
+        [communicator, registry](int signal)
         {
             cout << "Caught signal " << signal << ", shutting down..." << endl;
+
+            // Let all the connected clients know, and give them a few seconds to reply.
+            auto result = registry->broadcast("The wake-up service is shutting down!");
+            if (result.wait_for(5s) == future_status::ready)
+            {
+                Server::BroadcastResult broadcastResult = result.get();
+                cout << "Rang " << broadcastResult.clients << " alarm clock(s): " << broadcastResult.snoozed
+                     << " snoozed, " << broadcastResult.stopped << " stopped, " << broadcastResult.failed << " failed"
+                     << endl;
+            }
+
             communicator->shutdown();
         });
 
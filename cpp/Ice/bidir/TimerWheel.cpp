@@ -0,0 +1,152 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+Server::TimerWheel::TimerWheel(chrono::milliseconds tick)
+    : _tick{tick},
+      _origin{chrono::steady_clock::now()},
+      _thread{[this] { run(); }}
+{
+}
+
+Server::TimerWheel::~TimerWheel()
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _destroyed = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+void
+Server::TimerWheel::schedule(chrono::system_clock::time_point timePoint, Callback callback)
+{
+    // Convert the due time to the steady clock of the wheel, so that adjustments of the system clock don't move the
+    // pending timers.
+    auto delay = timePoint - chrono::system_clock::now();
+    auto elapsed = chrono::steady_clock::now() - _origin + chrono::duration_cast<chrono::steady_clock::duration>(delay);
+
+    // Round up to the next tick: a timer never fires early.
+    uint64_t expiration = 0;
+    if (elapsed.count() > 0)
+    {
+        expiration = static_cast<uint64_t>((elapsed + _tick - chrono::steady_clock::duration{1}) / _tick);
+    }
+
+    const lock_guard<mutex> lock(_mutex);
+
+    // A timer due now or in the past fires on the next tick.
+    insert(Timer{max(expiration, _currentTick + 1), std::move(callback)});
+    ++_size;
+}
+
+size_t
+Server::TimerWheel::size() const
+{
+    const lock_guard<mutex> lock(_mutex);
+    return _size;
+}
+
+void
+Server::TimerWheel::run()
+{
+    vector<Callback> dueCallbacks;
+
+    unique_lock<mutex> lock(_mutex);
+    while (!_destroyed)
+    {
+        _condition.wait_until(lock, _origin + _tick * (_currentTick + 1), [this] { return _destroyed; });
+        if (_destroyed)
+        {
+            break;
+        }
+
+        // Process all the ticks up to now. There is usually just one, unless the callbacks took longer than a tick.
+        auto now = static_cast<uint64_t>((chrono::steady_clock::now() - _origin) / _tick);
+        while (_currentTick < now)
+        {
+            ++_currentTick;
+
+            // When level 0 wraps around, refill it from level 1, and so on.
+            size_t index = _currentTick & (SlotsPerLevel - 1);
+            for (int level = 1; index == 0 && level < Levels; ++level)
+            {
+                index = cascade(level);
+            }
+
+            Slot& slot = _levels[0][_currentTick & (SlotsPerLevel - 1)];
+            for (auto& timer : slot)
+            {
+                dueCallbacks.push_back(std::move(timer.callback));
+            }
+            _size -= slot.size();
+            slot.clear();
+        }
+
+        if (!dueCallbacks.empty())
+        {
+            // Call the callbacks without holding the lock, so that they can schedule new timers.
+            lock.unlock();
+            for (auto& callback : dueCallbacks)
+            {
+                try
+                {
+                    callback();
+                }
+                catch (const std::exception& ex)
+                {
+                    cerr << "Timer callback failed: " << ex.what() << endl;
+                }
+            }
+            dueCallbacks.clear();
+            lock.lock();
+        }
+    }
+}
+
+void
+Server::TimerWheel::insert(Timer timer)
+{
+    // The expiration is never in the past: schedule clamps it to the next tick. When cascade moves a timer due on the
+    // current tick, the timer goes to the current slot of level 0, which the wheel drains right after cascading.
+
+    // Find the first level that spans the delay, and place the timer in this level according to its expiration. A
+    // delay longer than the wheel goes to the last level, in the slot the wheel reaches last.
+    uint64_t delay = timer.expiration - _currentTick;
+    int level = 0;
+    while (level < Levels - 1 && delay >= (uint64_t{1} << (LevelBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    uint64_t position = timer.expiration;
+    if (delay >= (uint64_t{1} << (LevelBits * Levels)))
+    {
+        position = _currentTick + (uint64_t{1} << (LevelBits * Levels)) - 1;
+    }
+
+    auto index = static_cast<size_t>((position >> (LevelBits * level)) & (SlotsPerLevel - 1));
+    _levels[static_cast<size_t>(level)][index].push_back(std::move(timer));
+}
+
+size_t
+Server::TimerWheel::cascade(int level)
+{
+    auto index = static_cast<size_t>((_currentTick >> (LevelBits * level)) & (SlotsPerLevel - 1));
+
+    // insert places each timer in a lower level, except the timers due after the span of the wheel, which go back to
+    // the last level.
+    Slot slot;
+    slot.swap(_levels[static_cast<size_t>(level)][index]);
+    for (auto& timer : slot)
+    {
+        insert(std::move(timer));
+    }
+    return index;
+}
@@ -0,0 +1,87 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Server
+{
+    /// TimerWheel is a hierarchical timer wheel: it calls scheduled callbacks at their due time from a single thread,
+    /// with a cost per timer that doesn't depend on the number of scheduled timers.
+    /// The wheel has 5 levels of 64 slots. A slot of level 0 spans one tick, and a slot of level n spans 64 slots of
+    /// level n - 1. When the wheel reaches a slot of level n > 0, it moves the timers of this slot to the lower levels.
+    /// A timer due after the span of the wheel (about 124 days with 10 ms ticks) waits in the last level until it gets
+    /// closer.
+    class TimerWheel final
+    {
+    public:
+        /// The type of the callbacks. A callback must not block: it delays all the other callbacks.
+        using Callback = std::function<void()>;
+
+        /// Constructs a TimerWheel and starts its thread.
+        /// @param tick The resolution of the wheel. A callback is called at most one tick after its due time.
+        explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds{10});
+
+        /// Stops the thread of the wheel. The pending callbacks are never called.
+        ~TimerWheel();
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        /// Schedules a callback.
+        /// @param timePoint The due time of the callback. If this time is in the past, the callback is called on the
+        /// next tick.
+        /// @param callback The callback.
+        void schedule(std::chrono::system_clock::time_point timePoint, Callback callback);
+
+        /// Gets the number of pending callbacks.
+        /// @return The number of pending callbacks.
+        size_t size() const;
+
+    private:
+        static constexpr int LevelBits = 6;
+        static constexpr size_t SlotsPerLevel = size_t{1} << LevelBits;
+        static constexpr int Levels = 5;
+
+        struct Timer
+        {
+            std::uint64_t expiration; // in ticks since _origin
+            Callback callback;
+        };
+
+        using Slot = std::vector<Timer>;
+
+        void run();
+
+        // Adds a timer to the slot matching its expiration, which must not be before _currentTick. Must be called with
+        // _mutex locked.
+        void insert(Timer timer);
+
+        // Moves the timers of the current slot of a level to the lower levels. Returns the index of this slot.
+        size_t cascade(int level);
+
+        const std::chrono::steady_clock::duration _tick;
+        const std::chrono::steady_clock::time_point _origin;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _destroyed{false};
+
+        // The last tick processed by the wheel thread.
+        std::uint64_t _currentTick{0};
+        size_t _size{0};
+        std::array<std::array<Slot, SlotsPerLevel>, Levels> _levels;
+
+        std::thread _thread; // must be the last member, since the thread uses the other members
+    };
+}
+
+#endif
@@ -0,0 +1,334 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "AlarmJournal.h"
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    // Compact the journal when it contains more than this number of lines and less than half of them describe
+    // current alarms.
+    constexpr size_t compactionThreshold = 1024;
+
+    std::FILE* openForAppend(const filesystem::path& path)
+    {
+        std::FILE* file = std::fopen(path.string().c_str(), "ab");
+        if (!file)
+        {
+            throw system_error{errno, generic_category(), "cannot open " + path.string()};
+        }
+        return file;
+    }
+
+    // Parses the integer at the start of a record field, and removes it from the field. Fails if the integer is not
+    // followed by a space or by the end of the line.
+    template<typename T> bool parseField(string_view& field, T& value)
+    {
+        const char* end = field.data() + field.size();
+        auto [next, ec] = from_chars(field.data(), end, value);
+        if (ec != errc{} || (next != end && *next != ' '))
+        {
+            return false;
+        }
+        field.remove_prefix(static_cast<size_t>(next - field.data()));
+        return true;
+    }
+
+    // Removes the space that separates two fields of a record.
+    bool skipSpace(string_view& line)
+    {
+        if (line.empty() || line.front() != ' ')
+        {
+            return false;
+        }
+        line.remove_prefix(1);
+        return true;
+    }
+
+    // Flushes a file to the OS, and syncs it to disk.
+    void sync(std::FILE* file)
+    {
+        bool synced = std::fflush(file) == 0;
+#ifdef _WIN32
+        synced = synced && _commit(_fileno(file)) == 0;
+#else
+        synced = synced && fsync(fileno(file)) == 0;
+#endif
+        if (!synced)
+        {
+            throw system_error{errno, generic_category(), "cannot sync alarm journal"};
+        }
+    }
+}
+
+Server::AlarmJournal::AlarmJournal(filesystem::path path, chrono::milliseconds flushInterval)
+    : _path{std::move(path)},
+      _flushInterval{flushInterval}
+{
+    replay();
+    _file = openForAppend(_path);
+    _thread = thread{[this] { run(); }};
+}
+
+Server::AlarmJournal::~AlarmJournal()
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _destroyed = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+    if (_file)
+    {
+        std::fclose(_file);
+    }
+}
+
+vector<Server::AlarmJournal::Alarm>
+Server::AlarmJournal::alarms() const
+{
+    const lock_guard<mutex> lock(_mutex);
+    vector<Alarm> alarms;
+    alarms.reserve(_alarms.size());
+    for (const auto& [id, alarm] : _alarms)
+    {
+        alarms.push_back(alarm);
+    }
+    return alarms;
+}
+
+uint64_t
+Server::AlarmJournal::add(int64_t timeStamp, string alarmClock)
+{
+    const lock_guard<mutex> lock(_mutex);
+    uint64_t id = _nextId++;
+    const Alarm& alarm = _alarms.emplace(id, Alarm{id, timeStamp, std::move(alarmClock)}).first->second;
+    _pending += addRecord(alarm);
+    ++_pendingRecords;
+    return id;
+}
+
+void
+Server::AlarmJournal::update(uint64_t id, int64_t timeStamp)
+{
+    const lock_guard<mutex> lock(_mutex);
+    auto p = _alarms.find(id);
+    if (p != _alarms.end())
+    {
+        // An update is a new add record with the same ID: the last record wins.
+        p->second.timeStamp = timeStamp;
+        _pending += addRecord(p->second);
+        ++_pendingRecords;
+    }
+}
+
+void
+Server::AlarmJournal::remove(uint64_t id)
+{
+    const lock_guard<mutex> lock(_mutex);
+    if (_alarms.erase(id) > 0)
+    {
+        _pending += "R " + to_string(id) + "\n";
+        ++_pendingRecords;
+    }
+}
+
+void
+Server::AlarmJournal::replay()
+{
+    ifstream in{_path};
+    string line;
+    while (getline(in, line))
+    {
+        if (in.eof())
+        {
+            // The last line has no newline: a crash interrupted its write. We skip it, and compact the journal before
+            // appending to it, so that the next record doesn't extend this partial line.
+            _rewriteNeeded = true;
+            break;
+        }
+
+        if (!replayRecord(line))
+        {
+            _rewriteNeeded = true;
+        }
+    }
+}
+
+bool
+Server::AlarmJournal::replayRecord(string_view line)
+{
+    // A record is "A <id> <timeStamp> <alarmClock>" or "R <id>".
+    if (line.size() < 2 || line[1] != ' ')
+    {
+        return false;
+    }
+    char type = line[0];
+    line.remove_prefix(2);
+
+    uint64_t id = 0;
+    if (!parseField(line, id))
+    {
+        return false;
+    }
+
+    if (type == 'A')
+    {
+        int64_t timeStamp = 0;
+        if (!skipSpace(line) || !parseField(line, timeStamp) || !skipSpace(line) || line.empty())
+        {
+            return false;
+        }
+        _alarms[id] = Alarm{id, timeStamp, string{line}};
+    }
+    else if (type == 'R' && line.empty())
+    {
+        _alarms.erase(id);
+    }
+    else
+    {
+        return false;
+    }
+
+    ++_records;
+    _nextId = max(_nextId, id + 1);
+    return true;
+}
+
+void
+Server::AlarmJournal::run()
+{
+    unique_lock<mutex> lock(_mutex);
+    while (true)
+    {
+        _condition.wait_for(lock, _flushInterval, [this] { return _destroyed; });
+
+        // We take the pending lines, and put them back if we fail to write them, so that they are retried at the
+        // next interval.
+        string pending;
+        pending.swap(_pending);
+        size_t pendingRecords = _pendingRecords;
+        _pendingRecords = 0;
+
+        size_t records = _records + pendingRecords;
+        bool compacting = _rewriteNeeded || (records > compactionThreshold && records > 2 * _alarms.size());
+        string snapshot;
+        if (compacting)
+        {
+            // The snapshot of the alarms replaces the file and the pending lines.
+            for (const auto& [id, alarm] : _alarms)
+            {
+                snapshot += addRecord(alarm);
+            }
+        }
+        size_t snapshotRecords = _alarms.size();
+        bool destroyed = _destroyed;
+
+        // Write without holding the lock, so that add, update and remove never wait for the disk.
+        lock.unlock();
+        bool written = false;
+        try
+        {
+            if (compacting)
+            {
+                compact(snapshot);
+            }
+            else if (!pending.empty())
+            {
+                write(pending);
+            }
+            written = true;
+        }
+        catch (const std::exception& ex)
+        {
+            cerr << "Alarm journal error: " << ex.what() << endl;
+        }
+        lock.lock();
+
+        if (written)
+        {
+            _records = compacting ? snapshotRecords : _records + pendingRecords;
+            _rewriteNeeded = false;
+        }
+        else
+        {
+            // The lines added while we were writing go after the lines we failed to write.
+            _pending.insert(0, pending);
+            _pendingRecords += pendingRecords;
+            _rewriteNeeded = true;
+        }
+
+        if (destroyed)
+        {
+            break;
+        }
+    }
+}
+
+void
+Server::AlarmJournal::write(const string& data)
+{
+    if (std::fwrite(data.data(), 1, data.size(), _file) != data.size())
+    {
+        throw system_error{errno, generic_category(), "cannot write alarm journal"};
+    }
+    sync(_file);
+}
+
+void
+Server::AlarmJournal::compact(const string& snapshot)
+{
+    // Write the snapshot to a temporary file, then rename it: a crash during compaction leaves either the old or the
+    // new journal, never a partial one.
+    filesystem::path tmpPath = _path;
+    tmpPath += ".tmp";
+
+    std::FILE* tmpFile = std::fopen(tmpPath.string().c_str(), "wb");
+    if (!tmpFile)
+    {
+        throw system_error{errno, generic_category(), "cannot create " + tmpPath.string()};
+    }
+    bool written = std::fwrite(snapshot.data(), 1, snapshot.size(), tmpFile) == snapshot.size();
+    if (written)
+    {
+        sync(tmpFile);
+    }
+    std::fclose(tmpFile);
+    if (!written)
+    {
+        throw system_error{errno, generic_category(), "cannot write " + tmpPath.string()};
+    }
+
+    // Windows doesn't allow renaming over an open file. If the rename or the reopen fails, _file stays null until the
+    // next compaction.
+    if (_file)
+    {
+        std::fclose(_file);
+        _file = nullptr;
+    }
+    error_code ec;
+    filesystem::rename(tmpPath, _path, ec);
+    if (ec)
+    {
+        throw system_error{ec, "cannot replace " + _path.string()};
+    }
+    _file = openForAppend(_path);
+}
+
+string
+Server::AlarmJournal::addRecord(const Alarm& alarm)
+{
+    return "A " + to_string(alarm.id) + " " + to_string(alarm.timeStamp) + " " + alarm.alarmClock + "\n";
+}
@@ -0,0 +1,118 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef ALARM_JOURNAL_H
+#define ALARM_JOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Server
+{
+    /// AlarmJournal keeps the scheduled alarms of the wake-up service in an append-only file, so that they survive a
+    /// restart of the server.
+    /// Each change appends one line to the file. A background thread writes the new lines and syncs the file to disk
+    /// every flush interval: the callers never wait for the disk, and one sync covers all the changes of an interval.
+    /// A crash can lose the changes of the last interval; a clean shutdown loses nothing. When most of the lines
+    /// describe alarms that no longer exist, the background thread rewrites the file with only the current alarms.
+    /// After a failed write, the changes stay pending and the background thread rewrites the file at the next interval.
+    class AlarmJournal final
+    {
+    public:
+        /// A scheduled alarm.
+        struct Alarm
+        {
+            /// The ID of the alarm in the journal.
+            std::uint64_t id;
+
+            /// The time of the next ring, in ticks (see WakeUpService::wakeMeUp).
+            std::int64_t timeStamp;
+
+            /// The stringified proxy of the alarm clock.
+            std::string alarmClock;
+        };
+
+        /// Opens a journal and replays the alarms it contains. Creates the journal if it doesn't exist yet.
+        /// @param path The path of the journal file.
+        /// @param flushInterval The interval between two syncs of the file.
+        explicit AlarmJournal(
+            std::filesystem::path path,
+            std::chrono::milliseconds flushInterval = std::chrono::milliseconds{10});
+
+        /// Writes the pending changes to the file and closes it.
+        ~AlarmJournal();
+
+        AlarmJournal(const AlarmJournal&) = delete;
+        AlarmJournal& operator=(const AlarmJournal&) = delete;
+
+        /// Gets the alarms in the journal.
+        /// @return The alarms, sorted by ID.
+        std::vector<Alarm> alarms() const;
+
+        /// Adds an alarm.
+        /// @param timeStamp The time of the first ring.
+        /// @param alarmClock The stringified proxy of the alarm clock.
+        /// @return The ID of the new alarm.
+        std::uint64_t add(std::int64_t timeStamp, std::string alarmClock);
+
+        /// Reschedules an alarm, for example after the user pressed the snooze button.
+        /// @param id The ID of the alarm.
+        /// @param timeStamp The time of the next ring.
+        void update(std::uint64_t id, std::int64_t timeStamp);
+
+        /// Removes an alarm, for example after the user pressed the stop button.
+        /// @param id The ID of the alarm.
+        void remove(std::uint64_t id);
+
+    private:
+        void replay();
+
+        // Applies one line of the file to _alarms. Returns false if the line is not a valid record.
+        bool replayRecord(std::string_view line);
+
+        void run();
+
+        // Writes and syncs data to _file. Called only by the background thread, without holding _mutex.
+        void write(const std::string& data);
+
+        // Replaces the file with a snapshot of the alarms, and reopens it. Called only by the background thread,
+        // without holding _mutex.
+        void compact(const std::string& snapshot);
+
+        static std::string addRecord(const Alarm& alarm);
+
+        const std::filesystem::path _path;
+        const std::chrono::milliseconds _flushInterval;
+        std::FILE* _file{nullptr}; // nullptr after a failed compaction, until the next compaction reopens the file
+
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _destroyed{false};
+
+        std::map<std::uint64_t, Alarm> _alarms;
+        std::uint64_t _nextId{1};
+
+        // The lines not yet written to the file.
+        std::string _pending;
+
+        // The number of lines in the file, and in _pending.
+        size_t _records{0};
+        size_t _pendingRecords{0};
+
+        // Set after a failed write, or when replay finds a partial or invalid line: the next write rewrites the whole
+        // file rather than appending a record to this line.
+        bool _rewriteNeeded{false};
+
+        std::thread _thread; // must be the last member, since the thread uses the other members
+    };
+}
+
+#endif
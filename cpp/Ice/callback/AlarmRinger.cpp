@@ -0,0 +1,112 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "AlarmRinger.h"
+#include "../../common/Time.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace EarlyRiser;
+using namespace std;
+
+Server::AlarmRinger::AlarmRinger(
+    const shared_ptr<TimerWheel>& timerWheel,
+    shared_ptr<AlarmJournal> journal,
+    size_t maxInFlight)
+    : _timerWheel{timerWheel},
+      _journal{std::move(journal)},
+      _maxInFlight{maxInFlight}
+{
+}
+
+void
+Server::AlarmRinger::ring(uint64_t id, AlarmClockPrx alarmClock, string message)
+{
+    Ring ring{id, std::move(alarmClock), std::move(message)};
+    {
+        const lock_guard<mutex> lock(_mutex);
+        if (_inFlight >= _maxInFlight)
+        {
+            _queue.push_back(std::move(ring));
+            return;
+        }
+        ++_inFlight;
+    }
+    send(std::move(ring));
+}
+
+void
+Server::AlarmRinger::send(Ring ring)
+{
+    // ringAsync doesn't block the calling thread: the reply is delivered to a thread from the Ice client thread pool.
+    auto self = shared_from_this();
+    auto sharedRing = make_shared<Ring>(std::move(ring));
+    sharedRing->alarmClock->ringAsync(
+        sharedRing->message,
+        [self, sharedRing](ButtonPressed buttonPressed) { self->completed(*sharedRing, buttonPressed); },
+        [self, sharedRing](exception_ptr exceptionPtr)
+        {
+            try
+            {
+                rethrow_exception(exceptionPtr);
+            }
+            catch (const Ice::CommunicatorDestroyedException&)
+            {
+                // The server is shutting down: keep the alarm in the journal.
+                self->sendNext();
+                return;
+            }
+            catch (const std::exception& ex)
+            {
+                cout << "Failed to ring alarm clock '" << sharedRing->alarmClock << "': " << ex.what() << endl;
+            }
+            self->completed(*sharedRing, nullopt);
+        });
+}
+
+void
+Server::AlarmRinger::completed(const Ring& ring, optional<ButtonPressed> buttonPressed)
+{
+    if (buttonPressed == ButtonPressed::Snooze)
+    {
+        if (auto wheel = _timerWheel.lock())
+        {
+            // Keep ringing every 10 seconds until the user presses the stop button.
+            auto timePoint = chrono::system_clock::now() + 10s;
+            _journal->update(ring.id, Time::toTimeStamp(timePoint));
+            wheel->schedule(
+                timePoint,
+                [self = shared_from_this(), id = ring.id, alarmClock = ring.alarmClock]
+                { self->ring(id, alarmClock, "No more snoozing!"); });
+        }
+    }
+    else
+    {
+        // The user pressed the stop button, or we can't reach this alarm clock: the alarm is done.
+        _journal->remove(ring.id);
+    }
+
+    sendNext();
+}
+
+void
+Server::AlarmRinger::sendNext()
+{
+    optional<Ring> next;
+    {
+        const lock_guard<mutex> lock(_mutex);
+        if (_queue.empty())
+        {
+            --_inFlight;
+        }
+        else
+        {
+            next = std::move(_queue.front());
+            _queue.pop_front();
+        }
+    }
+    if (next)
+    {
+        send(std::move(*next));
+    }
+}
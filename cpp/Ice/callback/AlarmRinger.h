@@ -0,0 +1,67 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef ALARM_RINGER_H
+#define ALARM_RINGER_H
+
+#include "AlarmClock.h"
+#include "AlarmJournal.h"
+#include "TimerWheel.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Server
+{
+    /// AlarmRinger rings the alarm clocks of due alarms with ringAsync, with a bounded number of rings in flight. When
+    /// many alarms are due at the same time, the extra rings wait in a queue instead of all opening connections and
+    /// sending requests at once. A ring that gets a Snooze reply is rescheduled in the timer wheel.
+    class AlarmRinger final : public std::enable_shared_from_this<AlarmRinger>
+    {
+    public:
+        /// Constructs an AlarmRinger.
+        /// @param timerWheel The timer wheel used to reschedule snoozed alarms. AlarmRinger keeps only a weak pointer
+        /// to this wheel, since the wheel holds the callbacks that call ring.
+        /// @param journal The journal that keeps the scheduled alarms.
+        /// @param maxInFlight The maximum number of ring requests waiting for a reply.
+        AlarmRinger(
+            const std::shared_ptr<TimerWheel>& timerWheel,
+            std::shared_ptr<AlarmJournal> journal,
+            size_t maxInFlight);
+
+        /// Rings an alarm clock now, or as soon as fewer than maxInFlight rings are in flight.
+        /// @param id The ID of the alarm in the journal.
+        /// @param alarmClock The alarm clock.
+        /// @param message The message to display on the alarm clock.
+        void ring(std::uint64_t id, EarlyRiser::AlarmClockPrx alarmClock, std::string message);
+
+    private:
+        struct Ring
+        {
+            std::uint64_t id;
+            EarlyRiser::AlarmClockPrx alarmClock;
+            std::string message;
+        };
+
+        // Sends a ring request.
+        void send(Ring ring);
+
+        // Handles the reply or failure of a ring request, and sends the next queued ring, if any.
+        void completed(const Ring& ring, std::optional<EarlyRiser::ButtonPressed> buttonPressed);
+
+        // Sends the next queued ring in place of a completed ring.
+        void sendNext();
+
+        const std::weak_ptr<TimerWheel> _timerWheel;
+        const std::shared_ptr<AlarmJournal> _journal;
+        const size_t _maxInFlight;
+
+        std::mutex _mutex;
+        size_t _inFlight{0};
+        std::deque<Ring> _queue;
+    };
+}
+
+#endif
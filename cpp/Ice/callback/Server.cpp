@@ -23,8 +23,11 @@ main(int argc, char* argv[])
     // Create an object adapter that listens for incoming requests and dispatches them to servants.
     auto adapter = communicator->createObjectAdapterWithEndpoints("WakeUpAdapter", "tcp -p 4061");
 
-    // Register the SimpleWakeUpService servant with the adapter.
-    adapter->add(make_shared<Server::SimpleWakeUpService>(), Ice::Identity{"wakeUpService"});
+    // Open the alarm journal. The alarms scheduled before the last shutdown are still in this journal.
+    auto journal = make_shared<Server::AlarmJournal>("alarms.journal");
+
+    // Register the SimpleWakeUpService servant with the adapter. The servant reschedules the alarms of the journal.
+    adapter->add(make_shared<Server::SimpleWakeUpService>(communicator, journal), Ice::Identity{"wakeUpService"});
 
     // Start dispatching requests.
     adapter->activate();
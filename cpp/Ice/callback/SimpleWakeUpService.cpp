@@ -3,20 +3,35 @@
 #include "SimpleWakeUpService.h"
 #include "../../common/Time.h"
 
-#include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <thread>
 
 using namespace EarlyRiser;
 using namespace std;
 
-Server::SimpleWakeUpService::~SimpleWakeUpService()
+Server::SimpleWakeUpService::SimpleWakeUpService(
+    const Ice::CommunicatorPtr& communicator,
+    shared_ptr<AlarmJournal> journal)
+    : _journal{std::move(journal)},
+      _ringer{make_shared<AlarmRinger>(_timerWheel, _journal, 100)}
 {
-    // Waits for all outstanding tasks to complete.
-    for (const auto& task : _tasks)
+    // Reschedule the alarms saved before the last shutdown. The alarms due while the server was down ring right away.
+    for (const auto& alarm : _journal->alarms())
     {
-        task.wait();
+        optional<AlarmClockPrx> alarmClock;
+        try
+        {
+            alarmClock = AlarmClockPrx{communicator, alarm.alarmClock};
+        }
+        catch (const Ice::ParseException& ex)
+        {
+            // A corrupted journal must not prevent the server from starting: we drop this alarm.
+            cout << "Dropping alarm " << alarm.id << " with invalid alarm clock '" << alarm.alarmClock
+                 << "': " << ex.what() << endl;
+            _journal->remove(alarm.id);
+            continue;
+        }
+        schedule(alarm.id, std::move(*alarmClock), alarm.timeStamp);
     }
 }
 
@@ -32,32 +47,16 @@ Server::SimpleWakeUpService::wakeMeUp(optional<AlarmClockPrx> alarmClock, int64_
     cout << "Dispatching wakeMeUp request { alarmClock = '" << alarmClock << "', timeStamp = " << timeStamp
          << " ticks }" << endl;
 
-    chrono::system_clock::time_point timePoint = Time::toTimePoint(timeStamp);
+    // Save the alarm before scheduling it, so that it survives a restart of the server.
+    uint64_t id = _journal->add(timeStamp, alarmClock->ice_toString());
+    schedule(id, std::move(*alarmClock), timeStamp);
+}
 
-    // Schedule a wake-up call in a background task.
-    _tasks.emplace_back(std::async(
-        std::launch::async,
-        [alarmClock = std::move(alarmClock), timePoint]()
-        {
-            // Sleep until the specified time point.
-            this_thread::sleep_until(timePoint);
-
-            // First ring.
-            ButtonPressed buttonPressed = alarmClock->ring("It's time to wake up!");
-
-            // Keep ringing every 10 seconds until the user presses the stop button.
-            while (buttonPressed == ButtonPressed::Snooze)
-            {
-                this_thread::sleep_for(10s);
-                buttonPressed = alarmClock->ring("No more snoozing!");
-            }
-        }));
-
-    // We don't want the _tasks vector to grow forever so remove all completed tasks here, without waiting.
-    _tasks.erase(
-        std::remove_if(
-            _tasks.begin(),
-            _tasks.end(),
-            [](const auto& task) { return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }),
-        _tasks.end());
+void
+Server::SimpleWakeUpService::schedule(uint64_t id, AlarmClockPrx alarmClock, int64_t timeStamp)
+{
+    _timerWheel->schedule(
+        Time::toTimePoint(timeStamp),
+        [ringer = _ringer, id, alarmClock = std::move(alarmClock)]
+        { ringer->ring(id, alarmClock, "It's time to wake up!"); });
 }
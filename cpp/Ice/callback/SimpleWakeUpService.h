@@ -4,9 +4,11 @@
 #define SIMPLE_WAKE_UP_SERVICE_H
 
 #include "AlarmClock.h"
+#include "AlarmJournal.h"
+#include "AlarmRinger.h"
+#include "TimerWheel.h"
 
-#include <future>
-#include <vector>
+#include <memory>
 
 namespace Server
 {
@@ -14,15 +16,27 @@ namespace Server
     class SimpleWakeUpService : public EarlyRiser::WakeUpService
     {
     public:
-        // Waits for all outstanding tasks to complete.
-        ~SimpleWakeUpService() override;
+        /// Constructs a SimpleWakeUpService servant and reschedules the alarms saved in the journal.
+        /// @param communicator The communicator used to recreate the alarm clock proxies saved in the journal.
+        /// @param journal The journal that keeps the scheduled alarms.
+        SimpleWakeUpService(const Ice::CommunicatorPtr& communicator, std::shared_ptr<AlarmJournal> journal);
 
         // Implements the pure virtual function in the base class (WakeUpService) generated by the Slice compiler.
         void wakeMeUp(std::optional<EarlyRiser::AlarmClockPrx> alarmClock, std::int64_t timeStamp, const Ice::Current&)
             override;
 
     private:
-        std::vector<std::future<void>> _tasks;
+        // Schedules the first ring of an alarm.
+        void schedule(std::uint64_t id, EarlyRiser::AlarmClockPrx alarmClock, std::int64_t timeStamp);
+
+        const std::shared_ptr<AlarmJournal> _journal;
+
+        // All the wake-up calls share the thread of this timer wheel. The destruction of the servant stops the wheel;
+        // the wake-up calls that are not due yet remain in the journal.
+        const std::shared_ptr<TimerWheel> _timerWheel = std::make_shared<TimerWheel>();
+
+        // Rings the alarm clocks of the due alarms, with at most 100 rings in flight.
+        const std::shared_ptr<AlarmRinger> _ringer;
     };
 }
 
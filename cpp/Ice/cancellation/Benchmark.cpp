@@ -0,0 +1,198 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "Greeter.h"
+
+#include <Ice/Ice.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    /// The delay of each slow greet request.
+    constexpr chrono::milliseconds slowDelay{100};
+
+    /// The duration of each benchmark run.
+    constexpr chrono::seconds runDuration{3};
+
+    /// The number of client threads. Each thread sends one request at a time.
+    constexpr int clientThreads = 8;
+
+    /// BenchmarkGreeter is like the demo's Chatbot, without the console output: printing each request would dominate
+    /// the latency of the fast greeter.
+    class BenchmarkGreeter : public VisitorCenter::Greeter
+    {
+    public:
+        explicit BenchmarkGreeter(chrono::milliseconds delay) : _delay{delay} {}
+
+        string greet(string name, const Ice::Current&) final
+        {
+            if (_delay > chrono::milliseconds::zero())
+            {
+                // Block a dispatch thread, like the slow greeter.
+                this_thread::sleep_for(_delay);
+            }
+            return "Hello, " + name + "!";
+        }
+
+    private:
+        const chrono::milliseconds _delay;
+    };
+
+    /// The results of a benchmark run.
+    struct Result
+    {
+        size_t fastRequests;
+        size_t slowRequests;
+        chrono::microseconds fastP50;
+        chrono::microseconds fastP99;
+        chrono::microseconds fastMax;
+    };
+
+    /// Runs the benchmark against a server.
+    /// @param slowLane When true, the server dispatches the slow greeter with its own object adapter and thread pool.
+    /// When false, the greeter and the slow greeter share the server thread pool.
+    /// @param slowPercent The percentage of requests sent to the slow greeter.
+    Result run(const Ice::PropertiesPtr& properties, bool slowLane, int slowPercent)
+    {
+        // Configure the server like the demo's server: at most 3 threads in the server thread pool.
+        Ice::InitializationData serverInitData;
+        serverInitData.properties = properties->clone();
+        serverInitData.properties->setProperty("Ice.ThreadPool.Server.SizeMax", "3");
+
+        // The slow lane has its own thread pool, with the same size.
+        serverInitData.properties->setProperty("SlowGreeterAdapter.ThreadPool.Size", "3");
+        serverInitData.properties->setProperty("SlowGreeterAdapter.ThreadPool.SizeMax", "3");
+        Ice::CommunicatorHolder server{Ice::initialize(serverInitData)};
+
+        auto adapter = server->createObjectAdapterWithEndpoints("GreeterAdapter", "tcp -h localhost -p 0");
+        Ice::ObjectAdapterPtr slowAdapter =
+            slowLane ? server->createObjectAdapterWithEndpoints("SlowGreeterAdapter", "tcp -h localhost -p 0")
+                     : adapter;
+
+        Ice::ObjectPrx greeterPrx = adapter->add(make_shared<BenchmarkGreeter>(0ms), Ice::Identity{"greeter"});
+        Ice::ObjectPrx slowGreeterPrx =
+            slowAdapter->add(make_shared<BenchmarkGreeter>(slowDelay), Ice::Identity{"slowGreeter"});
+        adapter->activate();
+        slowAdapter->activate();
+
+        // The client communicator doesn't share any connection with the server.
+        Ice::InitializationData clientInitData;
+        clientInitData.properties = properties->clone();
+        Ice::CommunicatorHolder client{Ice::initialize(clientInitData)};
+
+        VisitorCenter::GreeterPrx greeter{client.communicator(), greeterPrx->ice_toString()};
+        VisitorCenter::GreeterPrx slowGreeter{client.communicator(), slowGreeterPrx->ice_toString()};
+
+        // Establish the connections before starting the clock.
+        greeter->ice_ping();
+        slowGreeter->ice_ping();
+
+        mutex resultMutex;
+        vector<chrono::nanoseconds> fastLatencies;
+        size_t slowRequests = 0;
+
+        auto end = chrono::steady_clock::now() + runDuration;
+
+        vector<thread> threads;
+        for (int i = 0; i < clientThreads; ++i)
+        {
+            threads.emplace_back(
+                [&, i]
+                {
+                    // Each thread picks the target of each request at random, with a fixed seed.
+                    minstd_rand random{static_cast<minstd_rand::result_type>(i + 1)};
+                    uniform_int_distribution<int> distribution{0, 99};
+
+                    vector<chrono::nanoseconds> latencies;
+                    size_t slowCount = 0;
+
+                    while (chrono::steady_clock::now() < end)
+                    {
+                        if (distribution(random) < slowPercent)
+                        {
+                            slowGreeter->greet("alice");
+                            ++slowCount;
+                        }
+                        else
+                        {
+                            auto requestStart = chrono::steady_clock::now();
+                            greeter->greet("bob");
+                            latencies.push_back(chrono::steady_clock::now() - requestStart);
+                        }
+                    }
+
+                    const lock_guard<mutex> lock(resultMutex);
+                    fastLatencies.insert(fastLatencies.end(), latencies.begin(), latencies.end());
+                    slowRequests += slowCount;
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        sort(fastLatencies.begin(), fastLatencies.end());
+        auto percentile = [&fastLatencies](double p)
+        {
+            if (fastLatencies.empty())
+            {
+                return chrono::microseconds::zero();
+            }
+            auto index = static_cast<size_t>(p * static_cast<double>(fastLatencies.size() - 1));
+            return chrono::duration_cast<chrono::microseconds>(fastLatencies[index]);
+        };
+
+        return {fastLatencies.size(), slowRequests, percentile(0.5), percentile(0.99), percentile(1.0)};
+    }
+
+    void printResult(const char* label, const Result& result)
+    {
+        double seconds = chrono::duration<double>(runDuration).count();
+        cout << "  " << left << setw(12) << label << right << fixed << setprecision(0) << setw(8)
+             << static_cast<double>(result.fastRequests) / seconds << " fast req/s" << setw(6)
+             << static_cast<double>(result.slowRequests) / seconds << " slow req/s" << setw(8)
+             << result.fastP50.count() << " us p50" << setw(8) << result.fastP99.count() << " us p99" << setw(8)
+             << result.fastMax.count() << " us max" << endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    // createProperties removes the Ice command-line options from argv; the remaining arguments are the percentages of
+    // slow requests to benchmark.
+    Ice::PropertiesPtr properties = Ice::createProperties(argc, argv);
+
+    vector<int> slowPercents;
+    for (int i = 1; i < argc; ++i)
+    {
+        slowPercents.push_back(clamp(atoi(argv[i]), 0, 100));
+    }
+    if (slowPercents.empty())
+    {
+        slowPercents = {0, 5, 10, 25, 50};
+    }
+
+    cout << "Measuring the latency of the fast greeter with " << clientThreads << " client threads, while some requests"
+         << " go to a slow greeter (" << slowDelay.count() << " ms per request)..." << endl;
+
+    for (int slowPercent : slowPercents)
+    {
+        cout << endl << "Slow requests: " << slowPercent << "%" << endl;
+        printResult("shared pool", run(properties, false, slowPercent));
+        printResult("slow lane", run(properties, true, slowPercent));
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "CancellationToken.h"
+#include "Deadline.h"
+
+using namespace std;
+
+Server::CancellationToken::CancellationToken(optional<chrono::system_clock::time_point> deadline) : _deadline{deadline}
+{
+}
+
+Server::CancellationReason
+Server::CancellationToken::reason() const
+{
+    const lock_guard<mutex> lock(_mutex);
+    if (_reason == CancellationReason::None && _deadline && *_deadline <= chrono::system_clock::now())
+    {
+        return CancellationReason::DeadlineExceeded;
+    }
+    return _reason;
+}
+
+bool
+Server::CancellationToken::waitUntil(chrono::system_clock::time_point timePoint) const
+{
+    // Stop waiting at the deadline if it comes first.
+    bool deadlineFirst = _deadline && *_deadline < timePoint;
+
+    unique_lock<mutex> lock(_mutex);
+    if (_condition.wait_until(
+            lock,
+            deadlineFirst ? *_deadline : timePoint,
+            [this] { return _reason != CancellationReason::None; }))
+    {
+        return true;
+    }
+    return deadlineFirst;
+}
+
+void
+Server::CancellationToken::cancel(CancellationReason reason)
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        if (_reason != CancellationReason::None)
+        {
+            return;
+        }
+        _reason = reason;
+    }
+    _condition.notify_all();
+}
+
+shared_ptr<Server::CancellationToken>
+Server::DispatchCancellation::createToken(const Ice::Current& current)
+{
+    const Ice::Connection* connection = current.con.get();
+
+    // The deleter removes the token from _tokens when the dispatch releases the token.
+    shared_ptr<CancellationToken> token{
+        new CancellationToken{Deadline::read(current.ctx)},
+        [weakSelf = weak_from_this(), connection](CancellationToken* t)
+        {
+            if (auto self = weakSelf.lock())
+            {
+                self->remove(connection, t);
+            }
+            delete t;
+        }};
+
+    bool newConnection = false;
+    {
+        const lock_guard<mutex> lock(_mutex);
+        if (_shutdown)
+        {
+            token->cancel(CancellationReason::Shutdown);
+            return token;
+        }
+
+        if (connection)
+        {
+            auto& tokens = _tokens[connection];
+            newConnection = tokens.empty();
+            tokens.insert(token.get());
+        }
+        // A collocated dispatch has no connection; only the deadline and shutdown can cancel it.
+    }
+
+    if (newConnection)
+    {
+        // Install the close callback outside the lock: if the connection is already closed, Ice calls the callback
+        // right away.
+        current.con->setCloseCallback(
+            [weakSelf = weak_from_this()](const Ice::ConnectionPtr& closedConnection)
+            {
+                if (auto self = weakSelf.lock())
+                {
+                    self->connectionClosed(closedConnection.get());
+                }
+            });
+    }
+
+    return token;
+}
+
+void
+Server::DispatchCancellation::shutdown()
+{
+    const lock_guard<mutex> lock(_mutex);
+    _shutdown = true;
+    for (const auto& [connection, tokens] : _tokens)
+    {
+        for (CancellationToken* token : tokens)
+        {
+            token->cancel(CancellationReason::Shutdown);
+        }
+    }
+}
+
+void
+Server::DispatchCancellation::remove(const Ice::Connection* connection, CancellationToken* token)
+{
+    const lock_guard<mutex> lock(_mutex);
+    auto p = _tokens.find(connection);
+    if (p != _tokens.end())
+    {
+        p->second.erase(token);
+        if (p->second.empty())
+        {
+            _tokens.erase(p);
+        }
+    }
+}
+
+void
+Server::DispatchCancellation::connectionClosed(const Ice::Connection* connection)
+{
+    const lock_guard<mutex> lock(_mutex);
+    auto p = _tokens.find(connection);
+    if (p != _tokens.end())
+    {
+        for (CancellationToken* token : p->second)
+        {
+            token->cancel(CancellationReason::ConnectionClosed);
+        }
+        _tokens.erase(p);
+    }
+}
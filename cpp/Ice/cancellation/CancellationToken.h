@@ -0,0 +1,101 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <Ice/Ice.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+
+namespace Server
+{
+    /// The reason a dispatch was canceled.
+    enum class CancellationReason
+    {
+        /// The dispatch is not canceled.
+        None,
+
+        /// The connection that carried the request was closed: nobody can receive the response.
+        ConnectionClosed,
+
+        /// The deadline of the request has passed: the client no longer waits for the response.
+        DeadlineExceeded,
+
+        /// The server is shutting down.
+        Shutdown
+    };
+
+    /// A CancellationToken tells a long-running dispatch that it should stop as soon as possible. The dispatch can poll
+    /// the token with isCanceled, or wait on the token instead of sleeping.
+    class CancellationToken final
+    {
+    public:
+        /// Constructs a CancellationToken. Use DispatchCancellation::createToken instead.
+        /// @param deadline The deadline of the request, if any.
+        explicit CancellationToken(std::optional<std::chrono::system_clock::time_point> deadline);
+
+        /// Checks whether the dispatch is canceled.
+        /// @return true if the dispatch is canceled, false otherwise.
+        bool isCanceled() const { return reason() != CancellationReason::None; }
+
+        /// Gets the reason the dispatch was canceled.
+        /// @return The reason, or CancellationReason::None if the dispatch is not canceled.
+        CancellationReason reason() const;
+
+        /// Waits until the dispatch is canceled, or until a time point.
+        /// @param timePoint The time point.
+        /// @return true if the dispatch is canceled, false if timePoint was reached first.
+        bool waitUntil(std::chrono::system_clock::time_point timePoint) const;
+
+        /// Waits until the dispatch is canceled, or for a duration.
+        /// @param duration The duration.
+        /// @return true if the dispatch is canceled, false if the duration elapsed first.
+        bool waitFor(std::chrono::milliseconds duration) const
+        {
+            return waitUntil(std::chrono::system_clock::now() + duration);
+        }
+
+        /// Cancels the dispatch. Only the first reason is kept.
+        /// @param reason The reason.
+        void cancel(CancellationReason reason);
+
+    private:
+        const std::optional<std::chrono::system_clock::time_point> _deadline;
+        mutable std::mutex _mutex;
+        mutable std::condition_variable _condition;
+        CancellationReason _reason{CancellationReason::None};
+    };
+
+    /// DispatchCancellation creates the cancellation tokens of the dispatches of a server, and cancels them when their
+    /// connection closes or when the server shuts down. The tokens also cancel themselves at the deadline of their
+    /// request.
+    class DispatchCancellation final : public std::enable_shared_from_this<DispatchCancellation>
+    {
+    public:
+        /// Creates the cancellation token of a dispatch.
+        /// @param current The current object of the dispatch.
+        /// @return The cancellation token. The token is tracked until the dispatch releases it.
+        std::shared_ptr<CancellationToken> createToken(const Ice::Current& current);
+
+        /// Cancels all the dispatches, and the dispatches that start afterwards.
+        void shutdown();
+
+    private:
+        void remove(const Ice::Connection* connection, CancellationToken* token);
+        void connectionClosed(const Ice::Connection* connection);
+
+        std::mutex _mutex;
+        bool _shutdown{false};
+
+        // The tokens of the ongoing dispatches, by connection. A token removes itself when the dispatch releases it.
+        std::map<const Ice::Connection*, std::set<CancellationToken*>> _tokens;
+    };
+}
+
+#endif
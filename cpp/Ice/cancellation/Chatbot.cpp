@@ -1,36 +1,54 @@
 // Copyright (c) ZeroC, Inc.
 
 #include "Chatbot.h"
+#include "Deadline.h"
 
-#include <future>
 #include <iostream>
 #include <sstream>
 
 using namespace std;
 
-Server::Chatbot::Chatbot(std::chrono::milliseconds delay, std::shared_future<void> cancelDispatch)
+Server::Chatbot::Chatbot(std::chrono::milliseconds delay, std::shared_ptr<DispatchCancellation> cancellation)
     : _delay{delay},
-      _cancelDispatch{std::move(cancelDispatch)}
+      _cancellation{std::move(cancellation)}
 {
 }
 
 string
-Server::Chatbot::greet(string name, const Ice::Current&)
+Server::Chatbot::greet(string name, const Ice::Current& current)
 {
     cout << "Dispatching greet request { name = '" << name << "' }" << endl;
 
     if (_delay > std::chrono::milliseconds::zero())
     {
-        // Each thread needs its own copy of the shared_future.
-        shared_future<void> cancelDispatch{_cancelDispatch};
+        // The token of this dispatch is canceled when the client's connection closes, at the deadline of the request,
+        // or when the server shuts down.
+        shared_ptr<CancellationToken> token = _cancellation->createToken(current);
 
-        // Wait for delay or until _cancelDispatch is completed.
+        // Wait for delay, or until the token is canceled.
         // This call blocks a dispatch thread from the Ice server thread pool, which means we need to configure the
         // Ice server thread pool to have enough threads.
-        if (cancelDispatch.wait_for(_delay) == std::future_status::ready)
+        if (token->waitFor(_delay))
         {
-            cout << "greet dispatch canceled { name = '" << name << "' }" << endl;
-            throw Ice::UnknownException{__FILE__, __LINE__, "greet dispatch canceled"};
+            switch (token->reason())
+            {
+                case CancellationReason::DeadlineExceeded:
+                    cout << "greet dispatch aborted at its deadline { name = '" << name << "' }" << endl;
+                    throw Ice::DispatchException{
+                        __FILE__,
+                        __LINE__,
+                        Deadline::DeadlineExceeded,
+                        "greet deadline exceeded"};
+
+                case CancellationReason::ConnectionClosed:
+                    // Nobody is left to receive the response; Ice discards it.
+                    cout << "greet dispatch canceled, connection closed { name = '" << name << "' }" << endl;
+                    throw Ice::UnknownException{__FILE__, __LINE__, "greet dispatch canceled: connection closed"};
+
+                default:
+                    cout << "greet dispatch canceled { name = '" << name << "' }" << endl;
+                    throw Ice::UnknownException{__FILE__, __LINE__, "greet dispatch canceled"};
+            }
         }
     }
 
@@ -3,6 +3,7 @@
 #ifndef CHATBOT_H
 #define CHATBOT_H
 
+#include "CancellationToken.h"
 #include "Greeter.h"
 
 namespace Server
@@ -13,8 +14,8 @@ namespace Server
     public:
         /// Creates a new Chatbot instance with a delay.
         /// @param delay The delay before returning each greeting.
-        /// @param cancelDispatch A shared future that triggers the cancellation of all dispatches.
-        Chatbot(std::chrono::milliseconds delay, std::shared_future<void> cancelDispatch);
+        /// @param cancellation Creates the cancellation token of each greet dispatch.
+        Chatbot(std::chrono::milliseconds delay, std::shared_ptr<DispatchCancellation> cancellation);
 
         // Creates a new Chatbot instance with no delay.
         Chatbot() = default;
@@ -24,8 +25,8 @@ namespace Server
         std::string greet(std::string name, const Ice::Current&) override;
 
     private:
-        std::chrono::milliseconds _delay;
-        std::shared_future<void> _cancelDispatch;
+        std::chrono::milliseconds _delay{0};
+        std::shared_ptr<DispatchCancellation> _cancellation;
     };
 }
 
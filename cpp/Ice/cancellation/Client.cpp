@@ -1,6 +1,7 @@
 // Copyright (c) ZeroC, Inc.
 
 #include "../../common/Env.h"
+#include "Deadline.h"
 #include "Greeter.h"
 
 #include <Ice/Ice.h>
@@ -36,16 +37,28 @@ main(int argc, char* argv[])
     // infinite).
     VisitorCenter::GreeterPrx slowGreeter4s = slowGreeter->ice_invocationTimeout(4s);
 
-    // Send a request to the slow greeter with the 4-second invocation timeout.
+    // Send a request to the slow greeter with the 4-second invocation timeout. We also tell the server when we stop
+    // waiting, with a deadline in the request context: the server aborts the dispatch at this deadline instead of
+    // holding a thread for the full delay.
     try
     {
-        greeting = slowGreeter4s->greet("alice");
+        greeting = slowGreeter4s->greet("alice", Deadline::fromTimeout(4s));
         cout << "Received unexpected greeting: " << greeting << endl;
     }
     catch (const Ice::InvocationTimeoutException& exception)
     {
         cout << "Caught InvocationTimeoutException, as expected: " << exception.what() << endl;
     }
+    catch (const Ice::DispatchException& exception)
+    {
+        // The server's response can arrive just before the invocation timeout expires.
+        if (exception.replyStatus() != Deadline::DeadlineExceeded)
+        {
+            throw;
+        }
+        cout << "Caught DispatchException with reply status DeadlineExceeded, as expected: " << exception.what()
+             << endl;
+    }
 
     // Send a request to the slow greeter, and cancel this request after 4 seconds.
     function<void()> cancel = slowGreeter->greetAsync(
@@ -0,0 +1,69 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <Ice/Ice.h>
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// Deadlines tell the server when the client stops waiting for the response to a request. A deadline is an absolute
+/// time carried in the request context, so it remains the same when the request is forwarded to another server. It
+/// comes from the client's clock: the client and server clocks must be synchronized.
+namespace Deadline
+{
+    /// The key of the request context entry that carries the deadline, in milliseconds since the Unix epoch.
+    constexpr std::string_view Key = "deadline";
+
+    /// Adds a deadline to a request context.
+    /// @param context The request context.
+    /// @param deadline The deadline.
+    inline void set(Ice::Context& context, std::chrono::system_clock::time_point deadline)
+    {
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(deadline.time_since_epoch());
+        context[std::string{Key}] = std::to_string(milliseconds.count());
+    }
+
+    /// Creates a request context with a deadline.
+    /// @param timeout The time the client is willing to wait for the response, starting now. Use the same value as the
+    /// invocation timeout of the proxy.
+    /// @return A request context with the deadline.
+    inline Ice::Context fromTimeout(std::chrono::milliseconds timeout)
+    {
+        Ice::Context context;
+        set(context, std::chrono::system_clock::now() + timeout);
+        return context;
+    }
+
+    /// Reads the deadline of a request.
+    /// @param context The request context.
+    /// @return The deadline, or nullopt if the request context doesn't carry a valid deadline.
+    inline std::optional<std::chrono::system_clock::time_point> read(const Ice::Context& context)
+    {
+        auto p = context.find(std::string{Key});
+        if (p == context.end())
+        {
+            return std::nullopt;
+        }
+
+        std::int64_t milliseconds = 0;
+        const std::string& value = p->second;
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), milliseconds);
+        if (error != std::errc{} || end != value.data() + value.size())
+        {
+            return std::nullopt;
+        }
+        return std::chrono::system_clock::time_point{std::chrono::milliseconds{milliseconds}};
+    }
+
+    /// The reply status of the dispatch exception sent back when a request misses its deadline. This is a custom reply
+    /// status: its value is not used by Ice.
+    constexpr Ice::ReplyStatus DeadlineExceeded{static_cast<Ice::ReplyStatus>(100)};
+}
+
+#endif
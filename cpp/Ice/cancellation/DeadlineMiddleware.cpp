@@ -0,0 +1,34 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "DeadlineMiddleware.h"
+#include "Deadline.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+Server::DeadlineMiddleware::DeadlineMiddleware(Ice::ObjectPtr next) : _next{std::move(next)} {}
+
+void
+Server::DeadlineMiddleware::dispatch(Ice::IncomingRequest& request, function<void(Ice::OutgoingResponse)> sendResponse)
+{
+    optional<chrono::system_clock::time_point> deadline = Deadline::read(request.current().ctx);
+    if (deadline && *deadline <= chrono::system_clock::now())
+    {
+        uint64_t dropped = _dropped.fetch_add(1, memory_order_relaxed) + 1;
+
+        // Report at most once per second. Only the thread that wins the exchange writes to the console.
+        auto now = chrono::steady_clock::now().time_since_epoch().count();
+        auto lastReport = _lastReport.load(memory_order_relaxed);
+        if (now - lastReport >= chrono::steady_clock::duration{1s}.count() &&
+            _lastReport.compare_exchange_strong(lastReport, now, memory_order_relaxed))
+        {
+            cout << "Dropped " << dropped << " expired request(s) so far" << endl;
+        }
+        throw Ice::DispatchException{__FILE__, __LINE__, Deadline::DeadlineExceeded, "deadline exceeded"};
+    }
+
+    // Continue the dispatch pipeline.
+    _next->dispatch(request, std::move(sendResponse));
+}
@@ -0,0 +1,37 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef DEADLINE_MIDDLEWARE_H
+#define DEADLINE_MIDDLEWARE_H
+
+#include <Ice/Ice.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Server
+{
+    /// The DeadlineMiddleware rejects the requests whose deadline has already passed when their dispatch starts, for
+    /// example because they waited for a thread from the server thread pool. Nobody is waiting for their response, so
+    /// dispatching them would only waste capacity. The middleware counts the requests it drops, and reports this count
+    /// at most once per second, so that a burst of expired requests doesn't flood the console.
+    class DeadlineMiddleware final : public Ice::Object
+    {
+    public:
+        /// Constructs a DeadlineMiddleware.
+        /// @param next The next Ice::Object in the dispatch pipeline.
+        explicit DeadlineMiddleware(Ice::ObjectPtr next);
+
+        // Reimplements the dispatch function provided by Ice::Object.
+        void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
+
+    private:
+        const Ice::ObjectPtr _next;
+        std::atomic<std::uint64_t> _dropped{0};
+
+        // The time of the last report, in steady_clock ticks.
+        std::atomic<std::chrono::steady_clock::rep> _lastReport{0};
+    };
+}
+
+#endif
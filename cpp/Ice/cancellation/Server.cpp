@@ -1,9 +1,10 @@
 // Copyright (c) ZeroC, Inc.
 
+#include "CancellationToken.h"
 #include "Chatbot.h"
+#include "DeadlineMiddleware.h"
 
 #include <chrono>
-#include <future>
 #include <iostream>
 
 using namespace std;
@@ -29,13 +30,17 @@ main(int argc, char* argv[])
     // Create an object adapter that listens for incoming requests and dispatches them to servants.
     auto adapter = communicator->createObjectAdapterWithEndpoints("GreeterAdapter", "tcp -p 4061");
 
-    // Create a promise to cancel outstanding dispatches after the user presses Ctrl+C.
-    auto cancelDispatchPromise = make_shared<promise<void>>();
-    shared_future<void> cancelDispatch{cancelDispatchPromise->get_future()};
+    // Install the Deadline middleware in the object adapter. It drops the requests that are already expired when their
+    // dispatch starts.
+    adapter->use([](Ice::ObjectPtr next) { return make_shared<Server::DeadlineMiddleware>(std::move(next)); });
+
+    // Create the cancellation tokens of the slow greeter dispatches. A token is canceled when the client connection
+    // closes, at the deadline of the request, or after the user presses Ctrl+C.
+    auto cancellation = make_shared<Server::DispatchCancellation>();
 
     // Register two instances of Chatbot - a regular greater and a slow greeter.
     adapter->add(make_shared<Server::Chatbot>(), Ice::Identity{"greeter"});
-    adapter->add(make_shared<Server::Chatbot>(60s, cancelDispatch), Ice::Identity{"slowGreeter"});
+    adapter->add(make_shared<Server::Chatbot>(60s, cancellation), Ice::Identity{"slowGreeter"});
 
     // Start dispatching requests.
     adapter->activate();
@@ -43,16 +48,13 @@ main(int argc, char* argv[])
 
     // Shut down the communicator when the user presses Ctrl+C.
     ctrlCHandler.setCallback(
-        [communicator, cancelDispatchPromise, &ctrlCHandler](int signal)
+        [communicator, cancellation](int signal)
         {
             cout << "Caught signal " << signal << ", shutting down..." << endl;
             communicator->shutdown();
 
-            // Cancel outstanding dispatches "stuck" in the slow greeter.
-            cancelDispatchPromise->set_value();
-
-            // Clear the callback. Otherwise, a second Ctrl+C would call set_value again.
-            ctrlCHandler.setCallback(nullptr);
+            // Cancel outstanding dispatches "stuck" in the slow greeter. Calling shutdown again is harmless.
+            cancellation->shutdown();
         });
 
     // Wait until the communicator is shut down. Here, this occurs when the user presses Ctrl+C.
@@ -0,0 +1,128 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ContextValueMap.h"
+#include "GreetingCatalog.h"
+
+#include <Ice/Ice.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    /// The greeting code of the Chatbot before the greeting catalog: a string lookup and copy of the language, and an
+    /// ostringstream for each greeting.
+    string formatWithOstringstream(const string& name, const Ice::Context& context)
+    {
+        auto p = context.find("language");
+        string language = p != context.end() ? p->second : "";
+
+        ostringstream os;
+        if (language == "de")
+        {
+            os << "Hallo " << name << ", wie geht's?";
+        }
+        else if (language == "es")
+        {
+            os << "¡Hola " << name << "!";
+        }
+        else if (language == "fr")
+        {
+            os << "Bonjour " << name << ", comment vas-tu ?";
+        }
+        else
+        {
+            os << "Hello, " << name << "!";
+        }
+        return os.str();
+    }
+
+    /// Calls format for each name and context, iterations times, and returns the average time per greeting.
+    template<typename Format>
+    chrono::nanoseconds
+    run(const vector<string>& names, const vector<Ice::Context>& contexts, size_t iterations, Format format)
+    {
+        // Accumulate the greeting sizes, so that the compiler can't skip the formatting.
+        size_t totalSize = 0;
+
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            totalSize += format(names[i % names.size()], contexts[i % contexts.size()]);
+        }
+        auto elapsed = chrono::steady_clock::now() - start;
+
+        if (totalSize == 0)
+        {
+            cout << "unexpected empty greetings" << endl;
+        }
+        return elapsed / iterations;
+    }
+}
+
+int
+main()
+{
+    const Server::ContextValueMap<Server::Language> languages{
+        "language",
+        {{"de", Server::Language::German}, {"es", Server::Language::Spanish}, {"fr", Server::Language::French}},
+        Server::Language::English};
+    const Server::GreetingCatalog catalog = Server::GreetingCatalog::createDefault();
+
+    const vector<string> names{"alice", "bob", "carol", "dave", "maximilian-alexander"};
+    const vector<Ice::Context> contexts{{}, {{"language", "de"}}, {{"language", "es"}}, {{"language", "fr"}}};
+
+    // Both implementations must produce the same greetings.
+    for (const auto& name : names)
+    {
+        for (const auto& context : contexts)
+        {
+            if (formatWithOstringstream(name, context) != catalog.format(languages.lookup(context), name))
+            {
+                cout << "The greeting catalog and the ostringstream implementation disagree for " << name << endl;
+                return 1;
+            }
+        }
+    }
+
+    constexpr size_t iterations = 2'000'000;
+    cout << "Formatting " << iterations << " greetings..." << endl;
+
+    auto ostringstreamTime = run(
+        names,
+        contexts,
+        iterations,
+        [](const string& name, const Ice::Context& context) { return formatWithOstringstream(name, context).size(); });
+
+    auto catalogTime = run(
+        names,
+        contexts,
+        iterations,
+        [&](const string& name, const Ice::Context& context)
+        { return catalog.format(languages.lookup(context), name).size(); });
+
+    string buffer;
+    auto reusedBufferTime = run(
+        names,
+        contexts,
+        iterations,
+        [&](const string& name, const Ice::Context& context)
+        {
+            catalog.format(languages.lookup(context), name, buffer);
+            return buffer.size();
+        });
+
+    cout << "  " << left << setw(28) << "ostringstream" << right << setw(6) << ostringstreamTime.count()
+         << " ns/greeting" << endl;
+    cout << "  " << left << setw(28) << "catalog, new string" << right << setw(6) << catalogTime.count()
+         << " ns/greeting" << endl;
+    cout << "  " << left << setw(28) << "catalog, reused buffer" << right << setw(6) << reusedBufferTime.count()
+         << " ns/greeting" << endl;
+
+    return 0;
+}
@@ -3,37 +3,37 @@
 #include "Chatbot.h"
 
 #include <iostream>
-#include <sstream>
 
 using namespace std;
 
+namespace
+{
+    const char* toString(Server::Language language)
+    {
+        switch (language)
+        {
+            case Server::Language::French:
+                return "fr";
+            case Server::Language::German:
+                return "de";
+            case Server::Language::Spanish:
+                return "es";
+            default:
+                return "en";
+        }
+    }
+}
+
+Server::Chatbot::Chatbot(shared_ptr<const GreetingCatalog> catalog) : _catalog{std::move(catalog)} {}
+
 string
 Server::Chatbot::greet(string name, const Ice::Current& current)
 {
-    // We retrieve the value for the language entry in the context.
-    auto p = current.ctx.find("language");
-    string language = p != current.ctx.end() ? p->second : "";
+    // We retrieve the language from the language entry in the context.
+    Language language = _languages.lookup(current.ctx);
 
-    cout << "Dispatching greet request { name = '" << name << "', language = '" << language << "' }" << endl;
+    cout << "Dispatching greet request { name = '" << name << "', language = '" << toString(language) << "' }" << endl;
 
     // Return a greeting in the requested language.
-    ostringstream os;
-    if (language == "de")
-    {
-        os << "Hallo " << name << ", wie geht's?";
-    }
-    else if (language == "es")
-    {
-        os << "¡Hola " << name << "!";
-    }
-    else if (language == "fr")
-    {
-        os << "Bonjour " << name << ", comment vas-tu ?";
-    }
-    else
-    {
-        os << "Hello, " << name << "!";
-    }
-
-    return os.str();
+    return _catalog->format(language, name);
 }
@@ -3,7 +3,9 @@
 #ifndef CHATBOT_H
 #define CHATBOT_H
 
+#include "ContextValueMap.h"
 #include "Greeter.h"
+#include "GreetingCatalog.h"
 
 namespace Server
 {
@@ -11,9 +13,22 @@ namespace Server
     class Chatbot : public VisitorCenter::Greeter
     {
     public:
+        /// Constructs a Chatbot servant.
+        /// @param catalog The catalog of greetings.
+        explicit Chatbot(std::shared_ptr<const GreetingCatalog> catalog);
+
         // Implements the pure virtual function in the base class (VisitorCenter::Greeter) generated by the Slice
         // compiler.
         std::string greet(std::string name, const Ice::Current&) override;
+
+    private:
+        const std::shared_ptr<const GreetingCatalog> _catalog;
+
+        // Maps the language entry of the request context to a Language.
+        const ContextValueMap<Language> _languages{
+            "language",
+            {{"de", Language::German}, {"es", Language::Spanish}, {"fr", Language::French}},
+            Language::English};
     };
 }
 
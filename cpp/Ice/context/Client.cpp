@@ -1,6 +1,7 @@
 // Copyright (c) ZeroC, Inc.
 
 #include "../../common/Env.h"
+#include "ContextInterner.h"
 #include "Greeter.h"
 
 #include <Ice/Ice.h>
@@ -29,13 +30,17 @@ main(int argc, char* argv[])
     // or IP address.
     VisitorCenter::GreeterPrx greeter{communicator, "greeter:tcp -h localhost -p 4061"};
 
+    // The interner keeps a single copy of each context we use. Unlike a context literal such as {{"language", "fr"}},
+    // an interned context doesn't create a new map with new strings for each call.
+    ContextInterner contexts;
+
     // Send a request to the remote object and get the response. We request a French greeting by setting the context
     // parameter.
-    string greeting = greeter->greet(Env::getUsername(), {{"language", "fr"}});
+    string greeting = greeter->greet(Env::getUsername(), contexts.get("language", "fr"));
     cout << greeting << endl;
 
     // Do it again, this time by setting the context on the proxy.
-    auto greeterEs = greeter->ice_context({{"language", "es"}});
+    auto greeterEs = greeter->ice_context(contexts.get("language", "es"));
     greeting = greeterEs->greet("alice");
     cout << greeting << endl;
 
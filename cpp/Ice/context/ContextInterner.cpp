@@ -0,0 +1,47 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ContextInterner.h"
+
+using namespace std;
+
+const Ice::Context&
+ContextInterner::get(string_view key, string_view value)
+{
+    const lock_guard<mutex> lock(_mutex);
+    auto p = _contexts.find(Entry{key, value});
+    if (p == _contexts.end())
+    {
+        p = _contexts.insert(Ice::Context{{string{key}, string{value}}}).first;
+    }
+    return *p;
+}
+
+const Ice::Context&
+ContextInterner::intern(const Ice::Context& context)
+{
+    const lock_guard<mutex> lock(_mutex);
+    return *_contexts.insert(context).first;
+}
+
+int
+ContextInterner::Less::compare(const Ice::Context& context, const Entry& entry)
+{
+    // Compare the two sequences of entries lexicographically, like the operator< of std::map.
+    if (context.empty())
+    {
+        return -1;
+    }
+
+    const auto& [firstKey, firstValue] = *context.begin();
+    if (int c = string_view{firstKey}.compare(entry.key); c != 0)
+    {
+        return c;
+    }
+    if (int c = string_view{firstValue}.compare(entry.value); c != 0)
+    {
+        return c;
+    }
+
+    // The first entries are equal: the longer sequence is the greater one.
+    return context.size() > 1 ? 1 : 0;
+}
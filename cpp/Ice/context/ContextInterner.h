@@ -0,0 +1,56 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef CONTEXT_INTERNER_H
+#define CONTEXT_INTERNER_H
+
+#include <Ice/Ice.h>
+
+#include <mutex>
+#include <set>
+#include <string_view>
+
+/// ContextInterner keeps a single copy of each distinct request context. Passing an interned context to an invocation
+/// instead of a context literal such as {{"language", "fr"}} avoids creating a new map with new strings for each
+/// call.
+class ContextInterner final
+{
+public:
+    /// Gets the interned context with a single entry.
+    /// @param key The key of the entry.
+    /// @param value The value of the entry.
+    /// @return The interned context. This reference remains valid for the lifetime of the interner. This function
+    /// allocates only the first time it sees a given key and value.
+    const Ice::Context& get(std::string_view key, std::string_view value);
+
+    /// Gets the interned copy of a context.
+    /// @param context The context.
+    /// @return The interned context. This reference remains valid for the lifetime of the interner.
+    const Ice::Context& intern(const Ice::Context& context);
+
+private:
+    /// The key and value of a single-entry context, used to look up _contexts without creating an Ice::Context.
+    struct Entry
+    {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    /// Orders contexts as std::map does, and allows comparing contexts with single entries.
+    struct Less
+    {
+        using is_transparent = void;
+
+        bool operator()(const Ice::Context& lhs, const Ice::Context& rhs) const { return lhs < rhs; }
+        bool operator()(const Ice::Context& lhs, const Entry& rhs) const { return compare(lhs, rhs) < 0; }
+        bool operator()(const Entry& lhs, const Ice::Context& rhs) const { return compare(rhs, lhs) > 0; }
+
+        static int compare(const Ice::Context& context, const Entry& entry);
+    };
+
+    std::mutex _mutex;
+
+    // std::set never moves its elements, so the references we return remain valid.
+    std::set<Ice::Context, Less> _contexts;
+};
+
+#endif
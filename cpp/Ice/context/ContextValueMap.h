@@ -0,0 +1,63 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef CONTEXT_VALUE_MAP_H
+#define CONTEXT_VALUE_MAP_H
+
+#include <Ice/Ice.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Server
+{
+    /// ContextValueMap maps the value of a context entry to one of a fixed set of values, for example a language code
+    /// to a language enumerator. The key and the known values are created once: a lookup doesn't allocate any string,
+    /// and the rest of the dispatch uses the mapped value instead of the request's string.
+    template<typename T> class ContextValueMap final
+    {
+    public:
+        /// Constructs a ContextValueMap.
+        /// @param key The key of the context entry.
+        /// @param values The known values of the context entry, and the value each one maps to.
+        /// @param defaultValue The value to use when the context has no such entry, or when its value is unknown.
+        ContextValueMap(std::string key, std::initializer_list<std::pair<std::string, T>> values, T defaultValue)
+            : _key{std::move(key)},
+              _values{values},
+              _defaultValue{defaultValue}
+        {
+            std::sort(_values.begin(), _values.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        }
+
+        /// Looks up the context entry and maps its value.
+        /// @param context The request context.
+        /// @return The mapped value, or the default value.
+        T lookup(const Ice::Context& context) const
+        {
+            // _key is a std::string, so find doesn't create a temporary key for each request.
+            auto p = context.find(_key);
+            if (p == context.end())
+            {
+                return _defaultValue;
+            }
+
+            std::string_view value{p->second};
+            auto q = std::lower_bound(
+                _values.begin(),
+                _values.end(),
+                value,
+                [](const auto& entry, std::string_view v) { return std::string_view{entry.first} < v; });
+            return q != _values.end() && q->first == value ? q->second : _defaultValue;
+        }
+
+    private:
+        const std::string _key;
+        std::vector<std::pair<std::string, T>> _values; // sorted by string
+        const T _defaultValue;
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "GreetingCatalog.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace
+{
+    constexpr string_view namePlaceholder{"{name}"};
+}
+
+Server::GreetingCatalog
+Server::GreetingCatalog::createDefault()
+{
+    return GreetingCatalog{
+        {Language::English, "Hello, {name}!"},
+        {Language::French, "Bonjour {name}, comment vas-tu ?"},
+        {Language::German, "Hallo {name}, wie geht's?"},
+        {Language::Spanish, "¡Hola {name}!"}};
+}
+
+Server::GreetingCatalog::GreetingCatalog(initializer_list<pair<Language, string_view>> templates)
+{
+    CompiledTemplate english = compile("Hello, {name}!");
+    for (const auto& [language, text] : templates)
+    {
+        auto index = static_cast<size_t>(language);
+        assert(index < _templates.size());
+        _templates[index] = compile(text);
+        if (language == Language::English)
+        {
+            english = _templates[index];
+        }
+    }
+
+    // Fill the gaps with the English template.
+    for (auto& compiledTemplate : _templates)
+    {
+        if (compiledTemplate.segments.empty())
+        {
+            compiledTemplate = english;
+        }
+    }
+}
+
+void
+Server::GreetingCatalog::format(Language language, string_view name, string& buffer) const
+{
+    const CompiledTemplate& compiledTemplate = _templates[static_cast<size_t>(language)];
+
+    buffer.clear();
+    buffer.reserve(compiledTemplate.textSize + (compiledTemplate.segments.size() - 1) * name.size());
+
+    buffer.append(compiledTemplate.segments[0]);
+    for (size_t i = 1; i < compiledTemplate.segments.size(); ++i)
+    {
+        buffer.append(name);
+        buffer.append(compiledTemplate.segments[i]);
+    }
+}
+
+Server::GreetingCatalog::CompiledTemplate
+Server::GreetingCatalog::compile(string_view text)
+{
+    CompiledTemplate compiledTemplate;
+    size_t start = 0;
+    for (size_t pos = text.find(namePlaceholder); pos != string_view::npos; pos = text.find(namePlaceholder, start))
+    {
+        compiledTemplate.segments.emplace_back(text.substr(start, pos - start));
+        start = pos + namePlaceholder.size();
+    }
+    compiledTemplate.segments.emplace_back(text.substr(start));
+
+    for (const auto& segment : compiledTemplate.segments)
+    {
+        compiledTemplate.textSize += segment.size();
+    }
+    return compiledTemplate;
+}
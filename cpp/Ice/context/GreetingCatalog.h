@@ -0,0 +1,72 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef GREETING_CATALOG_H
+#define GREETING_CATALOG_H
+
+#include <array>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Server
+{
+    /// The languages supported by Chatbot.
+    enum class Language
+    {
+        English,
+        French,
+        German,
+        Spanish
+    };
+
+    /// GreetingCatalog holds a greeting template for each language. The templates are compiled once, when the catalog
+    /// is created: formatting a greeting only appends pre-split text and the name to a string, without ostringstream
+    /// and with at most one allocation.
+    class GreetingCatalog final
+    {
+    public:
+        /// Creates a catalog with the built-in templates.
+        /// @return The new catalog.
+        static GreetingCatalog createDefault();
+
+        /// Constructs a catalog.
+        /// @param templates The template of each language. The placeholder {name} stands for the name of the person
+        /// to greet. A language without a template uses the English template.
+        explicit GreetingCatalog(std::initializer_list<std::pair<Language, std::string_view>> templates);
+
+        /// Formats a greeting into a buffer. Reusing the same buffer avoids allocating once the buffer is large
+        /// enough.
+        /// @param language The language of the greeting.
+        /// @param name The name of the person to greet.
+        /// @param buffer The buffer. This function replaces its contents with the greeting.
+        void format(Language language, std::string_view name, std::string& buffer) const;
+
+        /// Formats a greeting.
+        /// @param language The language of the greeting.
+        /// @param name The name of the person to greet.
+        /// @return The greeting.
+        std::string format(Language language, std::string_view name) const
+        {
+            std::string greeting;
+            format(language, name, greeting);
+            return greeting;
+        }
+
+    private:
+        /// A compiled template: the text around the placeholders. There is a placeholder between each pair of
+        /// consecutive segments.
+        struct CompiledTemplate
+        {
+            std::vector<std::string> segments;
+            size_t textSize{0};
+        };
+
+        static CompiledTemplate compile(std::string_view text);
+
+        std::array<CompiledTemplate, 4> _templates; // indexed by Language
+    };
+}
+
+#endif
@@ -23,8 +23,11 @@ main(int argc, char* argv[])
     // Create an object adapter that listens for incoming requests and dispatches them to servants.
     auto adapter = communicator->createObjectAdapterWithEndpoints("GreeterAdapter", "tcp -p 4061");
 
+    // Load the greeting catalog once, at startup.
+    auto catalog = make_shared<const Server::GreetingCatalog>(Server::GreetingCatalog::createDefault());
+
     // Register the Chatbot servant with the adapter.
-    adapter->add(make_shared<Server::Chatbot>(), Ice::Identity{"greeter"});
+    adapter->add(make_shared<Server::Chatbot>(catalog), Ice::Identity{"greeter"});
 
     // Start dispatching requests.
     adapter->activate();
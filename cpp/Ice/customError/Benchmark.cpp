@@ -0,0 +1,246 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "GreeterAMD.h"
+#include "PrebuiltException.h"
+
+#include <Ice/Ice.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    /// The duration of each benchmark run.
+    constexpr chrono::seconds runDuration{3};
+
+    /// The number of client threads. Each thread sends one request at a time.
+    constexpr int clientThreads = 8;
+
+    /// Gets the CPU time, user and system, used so far by all the threads of the process.
+    chrono::microseconds processCpuTime()
+    {
+#ifdef _WIN32
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+
+        // FILETIME counts 100 ns intervals.
+        auto toMicroseconds = [](const FILETIME& time)
+        {
+            uint64_t ticks = (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+            return chrono::microseconds{static_cast<int64_t>(ticks / 10)};
+        };
+        return toMicroseconds(kernelTime) + toMicroseconds(userTime);
+#else
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        auto toMicroseconds = [](const timeval& time)
+        { return chrono::seconds{time.tv_sec} + chrono::microseconds{time.tv_usec}; };
+        return toMicroseconds(usage.ru_utime) + toMicroseconds(usage.ru_stime);
+#endif
+    }
+
+    /// The maximum length of a name, like in the demo's Chatbot.
+    constexpr size_t maxLength = 7;
+
+    /// ThrowingGreeter rejects long names like Server::Chatbot: it throws a new GreeterException for each rejected
+    /// request. Throwing from greetAsync has the same cost as throwing from a synchronous dispatch.
+    class ThrowingGreeter : public VisitorCenter::Greeter
+    {
+    public:
+        void greetAsync(
+            string name,
+            function<void(string_view)> response,
+            function<void(exception_ptr)>,
+            const Ice::Current&) final
+        {
+            if (name.length() > maxLength)
+            {
+                throw VisitorCenter::GreeterException{
+                    "Name is longer than maximum!",
+                    VisitorCenter::GreeterError::NameTooLong};
+            }
+            response("Hello, " + name + "!");
+        }
+    };
+
+    /// PrebuiltGreeter rejects long names like ServerAMD::Chatbot: it completes the dispatch with a pre-built
+    /// exception.
+    class PrebuiltGreeter : public VisitorCenter::Greeter
+    {
+    public:
+        void greetAsync(
+            string name,
+            function<void(string_view)> response,
+            function<void(exception_ptr)> exception,
+            const Ice::Current&) final
+        {
+            if (name.length() > maxLength)
+            {
+                _nameTooLong.reject(exception);
+            }
+            else
+            {
+                response("Hello, " + name + "!");
+            }
+        }
+
+    private:
+        const ServerAMD::PrebuiltException _nameTooLong{
+            VisitorCenter::GreeterException{"Name is longer than maximum!", VisitorCenter::GreeterError::NameTooLong}};
+    };
+
+    /// The results of a benchmark run.
+    struct Result
+    {
+        size_t requests;
+        size_t rejected;
+        chrono::microseconds p50;
+        chrono::microseconds p99;
+        double cpuPerRequest; // in microseconds
+    };
+
+    /// Runs the benchmark against a greeter hosted in the same process.
+    /// @param servant The greeter servant.
+    /// @param rejectPercent The percentage of requests rejected by the greeter.
+    Result run(const Ice::PropertiesPtr& properties, const Ice::ObjectPtr& servant, int rejectPercent)
+    {
+        Ice::InitializationData serverInitData;
+        serverInitData.properties = properties->clone();
+        Ice::CommunicatorHolder server{Ice::initialize(serverInitData)};
+
+        auto adapter = server->createObjectAdapterWithEndpoints("GreeterAdapter", "tcp -h localhost -p 0");
+        Ice::ObjectPrx greeterPrx = adapter->add(servant, Ice::Identity{"greeter"});
+        adapter->activate();
+
+        // The client communicator doesn't share any connection with the server.
+        Ice::InitializationData clientInitData;
+        clientInitData.properties = properties->clone();
+        Ice::CommunicatorHolder client{Ice::initialize(clientInitData)};
+
+        VisitorCenter::GreeterPrx greeter{client.communicator(), greeterPrx->ice_toString()};
+
+        // Establish the connection before starting the clock.
+        greeter->ice_ping();
+
+        mutex resultMutex;
+        vector<chrono::nanoseconds> allLatencies;
+        size_t rejected = 0;
+
+        auto end = chrono::steady_clock::now() + runDuration;
+        chrono::microseconds cpuStart = processCpuTime();
+
+        vector<thread> threads;
+        for (int i = 0; i < clientThreads; ++i)
+        {
+            threads.emplace_back(
+                [&, i]
+                {
+                    // Each thread picks the name of each request at random, with a fixed seed.
+                    minstd_rand random{static_cast<minstd_rand::result_type>(i + 1)};
+                    uniform_int_distribution<int> distribution{0, 99};
+
+                    vector<chrono::nanoseconds> latencies;
+                    size_t rejectedCount = 0;
+
+                    while (chrono::steady_clock::now() < end)
+                    {
+                        auto requestStart = chrono::steady_clock::now();
+                        try
+                        {
+                            greeter->greet(distribution(random) < rejectPercent ? "maximilian" : "dave");
+                        }
+                        catch (const VisitorCenter::GreeterException&)
+                        {
+                            ++rejectedCount;
+                        }
+                        latencies.push_back(chrono::steady_clock::now() - requestStart);
+                    }
+
+                    const lock_guard<mutex> lock(resultMutex);
+                    allLatencies.insert(allLatencies.end(), latencies.begin(), latencies.end());
+                    rejected += rejectedCount;
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        // The CPU time of the process includes the client, which does the same work in both runs.
+        auto cpuMicroseconds = static_cast<double>((processCpuTime() - cpuStart).count());
+
+        sort(allLatencies.begin(), allLatencies.end());
+        auto percentile = [&allLatencies](double p)
+        {
+            auto index = static_cast<size_t>(p * static_cast<double>(allLatencies.size() - 1));
+            return chrono::duration_cast<chrono::microseconds>(allLatencies[index]);
+        };
+
+        return {
+            allLatencies.size(),
+            rejected,
+            percentile(0.5),
+            percentile(0.99),
+            cpuMicroseconds / static_cast<double>(allLatencies.size())};
+    }
+
+    void printResult(const char* label, const Result& result)
+    {
+        double seconds = chrono::duration<double>(runDuration).count();
+        cout << "  " << left << setw(10) << label << right << fixed << setprecision(0) << setw(8)
+             << static_cast<double>(result.requests) / seconds << " req/s" << setw(8)
+             << static_cast<double>(result.rejected) / seconds << " rejected/s" << setw(6) << result.p50.count()
+             << " us p50" << setw(6) << result.p99.count() << " us p99" << setprecision(1) << setw(7)
+             << result.cpuPerRequest << " us CPU/req" << endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    // createProperties removes the Ice command-line options from argv; the remaining arguments are the percentages of
+    // rejected requests to benchmark.
+    Ice::PropertiesPtr properties = Ice::createProperties(argc, argv);
+
+    vector<int> rejectPercents;
+    for (int i = 1; i < argc; ++i)
+    {
+        rejectPercents.push_back(clamp(atoi(argv[i]), 0, 100));
+    }
+    if (rejectPercents.empty())
+    {
+        rejectPercents = {0, 30, 100};
+    }
+
+    cout << "Measuring greet requests with " << clientThreads << " client threads, when the greeter rejects some names "
+         << "with a GreeterException..." << endl;
+
+    for (int rejectPercent : rejectPercents)
+    {
+        cout << endl << "Rejected requests: " << rejectPercent << "%" << endl;
+        printResult("throw", run(properties, make_shared<ThrowingGreeter>(), rejectPercent));
+        printResult("prebuilt", run(properties, make_shared<PrebuiltGreeter>(), rejectPercent));
+    }
+
+    return 0;
+}
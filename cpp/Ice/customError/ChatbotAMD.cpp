@@ -0,0 +1,59 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ChatbotAMD.h"
+#include "../../common/Time.h"
+#include "ErrorMetricsMiddleware.h"
+#include "UserExceptionLabel.h"
+
+#include <Ice/Ice.h>
+#include <iostream>
+
+using namespace std;
+
+void
+ServerAMD::Chatbot::greetAsync(
+    string name,
+    function<void(string_view)> response,
+    function<void(std::exception_ptr)> exception,
+    const Ice::Current&)
+{
+    cout << "Dispatching greet request { name = '" << name << "' }" << endl;
+
+    if (name.empty())
+    {
+        // ObjectNotExistException is a dispatch exception with a reply status of 'ObjectNotExist'.
+        _objectNotExist.reject(exception);
+    }
+    else if (name == "alice")
+    {
+        // Simulate an authentication error with a dispatch exception with the Unauthorized error code.
+        // Note: This is a demo; no real authentication logic is implemented.
+        _unauthorized.reject(exception);
+    }
+    else if (name == "bob")
+    {
+        // This message depends on the current time, so we create a new exception. We don't need to throw it.
+        auto timeString = Time::formatTime(chrono::system_clock::now() + chrono::minutes(5));
+        VisitorCenter::GreeterException away{"Away until " + timeString + ".", VisitorCenter::GreeterError::Away};
+
+        // Label this exception for the ErrorMetrics middleware, which only sees the marshaled reply.
+        const Server::UserExceptionLabel label{
+            Server::classifyGreeterException<VisitorCenter::GreeterException>(away)};
+        exception(make_exception_ptr(std::move(away)));
+    }
+    else if (name == "carol")
+    {
+        // The label the ErrorMetrics middleware gives to this exception when Server::Chatbot throws it.
+        const Server::UserExceptionLabel label{"GreetingOtherVisitor"};
+        _greetingOtherVisitor.reject(exception);
+    }
+    else if (name.length() > _maxLength)
+    {
+        const Server::UserExceptionLabel label{"NameTooLong"};
+        _nameTooLong.reject(exception);
+    }
+    else
+    {
+        response("Hello, " + name + "!");
+    }
+}
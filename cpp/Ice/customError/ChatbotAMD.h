@@ -0,0 +1,43 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef CHATBOT_AMD_H
+#define CHATBOT_AMD_H
+
+#include "GreeterAMD.h"
+#include "PrebuiltException.h"
+
+namespace ServerAMD
+{
+    /// Chatbot is an Ice servant that implements Slice interface Greeter. Unlike Server::Chatbot, it doesn't throw:
+    /// it completes the dispatch of a rejected request with a pre-built exception.
+    class Chatbot : public VisitorCenter::Greeter
+    {
+    public:
+        // Implements the pure virtual function in the base class (VisitorCenter::Greeter) generated by the Slice
+        // compiler.
+        void greetAsync(
+            std::string name,
+            std::function<void(std::string_view returnValue)> response,
+            std::function<void(std::exception_ptr)> exception,
+            const Ice::Current& current) override;
+
+    private:
+        // The maximum length of a name.
+        static constexpr int _maxLength = 7;
+
+        // The exceptions that don't depend on the request are created once.
+        const PrebuiltException _objectNotExist{Ice::ObjectNotExistException{__FILE__, __LINE__}};
+        const PrebuiltException _unauthorized{Ice::DispatchException{
+            __FILE__,
+            __LINE__,
+            Ice::ReplyStatus::Unauthorized,
+            "Invalid credentials. The administrator has been notified."}};
+        const PrebuiltException _greetingOtherVisitor{VisitorCenter::GreeterException{
+            "I am already greeting someone else.",
+            VisitorCenter::GreeterError::GreetingOtherVisitor}};
+        const PrebuiltException _nameTooLong{
+            VisitorCenter::GreeterException{"Name is longer than maximum!", VisitorCenter::GreeterError::NameTooLong}};
+    };
+}
+
+#endif
@@ -1,6 +1,7 @@
 // Copyright (c) ZeroC, Inc.
 
 #include "../../common/Env.h"
+#include "ErrorMetrics.h"
 #include "Greeter.h"
 
 #include <Ice/Ice.h>
@@ -47,5 +48,11 @@ main(int argc, char* argv[])
         }
     }
 
+    // The server provides its error metrics through the ErrorMetrics facet of its Ice.Admin object.
+    Diagnostics::ErrorMetricsPrx errorMetrics{
+        communicator,
+        "customError/admin -f ErrorMetrics:tcp -h localhost -p 4062"};
+    cout << endl << "Server error metrics:" << endl << errorMetrics->dump();
+
     return 0;
 }
@@ -0,0 +1,107 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ErrorCounters.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+    vector<string> appendCatchAll(vector<string> names, const char* catchAll)
+    {
+        names.emplace_back(catchAll);
+        return names;
+    }
+
+    // Returns the index of name in names, or the index of the last (catch-all) entry when names doesn't contain name.
+    size_t indexOf(const vector<string>& names, string_view name) noexcept
+    {
+        auto p = find(names.begin(), names.end() - 1, name);
+        return static_cast<size_t>(p - names.begin());
+    }
+}
+
+Server::ErrorCounters::ErrorCounters(vector<string> operations, vector<string> exceptionLabels)
+    : _operations{appendCatchAll(std::move(operations), "*")},
+      _exceptionLabels{appendCatchAll(std::move(exceptionLabels), "other")},
+      _stride{ReplyStatusCount + _exceptionLabels.size()},
+      _counters{make_unique<atomic<uint64_t>[]>(_operations.size() * _stride)}
+{
+}
+
+void
+Server::ErrorCounters::recordReply(string_view operation, Ice::ReplyStatus replyStatus) noexcept
+{
+    size_t status = min(static_cast<size_t>(replyStatus), ReplyStatusCount - 1);
+    _counters[operationOffset(operation) + status].fetch_add(1, memory_order_relaxed);
+}
+
+void
+Server::ErrorCounters::recordUserException(string_view operation, string_view label) noexcept
+{
+    size_t index = ReplyStatusCount + indexOf(_exceptionLabels, label);
+    _counters[operationOffset(operation) + index].fetch_add(1, memory_order_relaxed);
+}
+
+string
+Server::ErrorCounters::dump() const
+{
+    ostringstream os;
+    for (size_t i = 0; i < _operations.size(); ++i)
+    {
+        size_t offset = i * _stride;
+
+        uint64_t total = 0;
+        for (size_t status = 0; status < ReplyStatusCount; ++status)
+        {
+            total += _counters[offset + status].load(memory_order_relaxed);
+        }
+        if (total == 0)
+        {
+            continue;
+        }
+
+        uint64_t errors = total - _counters[offset].load(memory_order_relaxed); // all but ReplyStatus::Ok
+        os << _operations[i] << ": " << total << " replies, " << errors << " errors (" << fixed << setprecision(1)
+           << 100.0 * static_cast<double>(errors) / static_cast<double>(total) << "%)\n";
+
+        for (size_t status = 0; status < ReplyStatusCount; ++status)
+        {
+            if (uint64_t count = _counters[offset + status].load(memory_order_relaxed); count > 0)
+            {
+                os << "  ";
+                if (status < ReplyStatusCount - 1)
+                {
+                    os << static_cast<Ice::ReplyStatus>(status);
+                }
+                else
+                {
+                    os << "reply status >= " << status;
+                }
+                os << ": " << count << '\n';
+            }
+
+            if (status == static_cast<size_t>(Ice::ReplyStatus::UserException))
+            {
+                for (size_t label = 0; label < _exceptionLabels.size(); ++label)
+                {
+                    if (uint64_t count = _counters[offset + ReplyStatusCount + label].load(memory_order_relaxed);
+                        count > 0)
+                    {
+                        os << "    " << _exceptionLabels[label] << ": " << count << '\n';
+                    }
+                }
+            }
+        }
+    }
+    return os.str();
+}
+
+size_t
+Server::ErrorCounters::operationOffset(string_view operation) const noexcept
+{
+    return indexOf(_operations, operation) * _stride;
+}
@@ -0,0 +1,65 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef ERROR_COUNTERS_H
+#define ERROR_COUNTERS_H
+
+#include <Ice/Ice.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Server
+{
+    /// ErrorCounters counts the replies of each operation by reply status, and the user exceptions of each operation
+    /// by label. The operations and the labels are fixed at construction, so recording a reply is a lookup in
+    /// immutable vectors followed by a relaxed atomic increment, without any lock.
+    class ErrorCounters final
+    {
+    public:
+        /// The number of reply status counters per operation. Reply statuses with a greater value share the last
+        /// counter.
+        static constexpr std::size_t ReplyStatusCount = 16;
+
+        /// Constructs an ErrorCounters object.
+        /// @param operations The operations to count. Other operations are counted under operation `*`.
+        /// @param exceptionLabels The user exception labels to count. Other labels are counted under label `other`.
+        ErrorCounters(std::vector<std::string> operations, std::vector<std::string> exceptionLabels);
+
+        /// Records a reply.
+        /// @param operation The name of the operation.
+        /// @param replyStatus The reply status.
+        void recordReply(std::string_view operation, Ice::ReplyStatus replyStatus) noexcept;
+
+        /// Records a user exception. The reply that carries this exception is recorded separately with recordReply.
+        /// @param operation The name of the operation.
+        /// @param label The label of the user exception.
+        void recordUserException(std::string_view operation, std::string_view label) noexcept;
+
+        /// Dumps the counters as a human-readable text report.
+        /// @return The text report.
+        [[nodiscard]] std::string dump() const;
+
+    private:
+        // Returns the counter index of an operation. The counters of an operation are contiguous: first the reply
+        // status counters, then one counter per exception label.
+        [[nodiscard]] std::size_t operationOffset(std::string_view operation) const noexcept;
+
+        // The operations, followed by `*`.
+        const std::vector<std::string> _operations;
+
+        // The user exception labels, followed by `other`.
+        const std::vector<std::string> _exceptionLabels;
+
+        // The number of counters per operation.
+        const std::size_t _stride;
+
+        std::unique_ptr<std::atomic<std::uint64_t>[]> _counters;
+    };
+}
+
+#endif
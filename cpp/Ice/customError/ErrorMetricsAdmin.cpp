@@ -0,0 +1,13 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ErrorMetricsAdmin.h"
+
+using namespace std;
+
+Server::ErrorMetricsAdmin::ErrorMetricsAdmin(shared_ptr<ErrorCounters> counters) : _counters{std::move(counters)} {}
+
+string
+Server::ErrorMetricsAdmin::dump(const Ice::Current&)
+{
+    return _counters->dump();
+}
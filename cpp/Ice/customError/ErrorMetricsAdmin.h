@@ -0,0 +1,29 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef ERROR_METRICS_ADMIN_H
+#define ERROR_METRICS_ADMIN_H
+
+#include "ErrorCounters.h"
+#include "ErrorMetrics.h"
+
+namespace Server
+{
+    /// ErrorMetricsAdmin is an Ice servant that implements Slice interface ErrorMetrics by dumping an ErrorCounters
+    /// object.
+    class ErrorMetricsAdmin final : public Diagnostics::ErrorMetrics
+    {
+    public:
+        /// Constructs an ErrorMetricsAdmin servant.
+        /// @param counters The counters to dump.
+        explicit ErrorMetricsAdmin(std::shared_ptr<ErrorCounters> counters);
+
+        // Implements the pure virtual function in the base class (Diagnostics::ErrorMetrics) generated by the Slice
+        // compiler.
+        std::string dump(const Ice::Current&) final;
+
+    private:
+        const std::shared_ptr<ErrorCounters> _counters;
+    };
+}
+
+#endif
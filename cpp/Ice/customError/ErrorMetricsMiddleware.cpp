@@ -0,0 +1,67 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ErrorMetricsMiddleware.h"
+#include "UserExceptionLabel.h"
+
+using namespace std;
+
+Server::ErrorMetricsMiddleware::ErrorMetricsMiddleware(
+    Ice::ObjectPtr next,
+    shared_ptr<ErrorCounters> counters,
+    UserExceptionClassifier classifier)
+    : _next{std::move(next)},
+      _counters{std::move(counters)},
+      _classifier{std::move(classifier)}
+{
+}
+
+void
+Server::ErrorMetricsMiddleware::dispatch(
+    Ice::IncomingRequest& request,
+    function<void(Ice::OutgoingResponse)> sendResponse)
+{
+    const string& operation = request.current().operation;
+
+    try
+    {
+        // Continue the dispatch pipeline, and record the reply when the response is sent.
+        _next->dispatch(
+            request,
+            [sendResponse = std::move(sendResponse), counters = _counters](Ice::OutgoingResponse response)
+            {
+                const string& responseOperation = response.current().operation;
+                counters->recordReply(responseOperation, response.replyStatus());
+                if (response.replyStatus() == Ice::ReplyStatus::UserException)
+                {
+                    // The response only carries the marshaled exception: we use the label set by the AMD servant that
+                    // sends this response, or else the type ID of the exception.
+                    string_view label = UserExceptionLabel::get();
+                    counters->recordUserException(responseOperation, label.empty() ? response.exceptionId() : label);
+                }
+                sendResponse(std::move(response));
+            });
+    }
+    catch (const Ice::UserException& exception)
+    {
+        // A synchronous servant reports errors by throwing an exception; Ice then creates the response from this
+        // exception, without calling the sendResponse function above.
+        _counters->recordReply(operation, Ice::ReplyStatus::UserException);
+        _counters->recordUserException(operation, _classifier(exception));
+        throw;
+    }
+    catch (const Ice::DispatchException& exception)
+    {
+        _counters->recordReply(operation, exception.replyStatus());
+        throw;
+    }
+    catch (const Ice::LocalException&)
+    {
+        _counters->recordReply(operation, Ice::ReplyStatus::UnknownLocalException);
+        throw;
+    }
+    catch (...)
+    {
+        _counters->recordReply(operation, Ice::ReplyStatus::UnknownException);
+        throw;
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef ERROR_METRICS_MIDDLEWARE_H
+#define ERROR_METRICS_MIDDLEWARE_H
+
+#include "ErrorCounters.h"
+
+#include <Ice/Ice.h>
+
+#include <functional>
+#include <string_view>
+
+namespace Server
+{
+    /// Classifies a user exception, for example by its error code. The returned string must outlive the call.
+    using UserExceptionClassifier = std::function<std::string_view(const Ice::UserException&)>;
+
+    /// Labels a GreeterException with its error code, and any other user exception with its type ID. The server and
+    /// serveramd generate GreeterException from different Slice files, so each instantiates this function with its own
+    /// GreeterException type.
+    /// @param exception The user exception to classify.
+    /// @return The label of the exception.
+    template<typename GreeterException> std::string_view classifyGreeterException(const Ice::UserException& exception)
+    {
+        if (auto greeterException = dynamic_cast<const GreeterException*>(&exception))
+        {
+            using GreeterError = decltype(greeterException->error);
+            switch (greeterException->error)
+            {
+                case GreeterError::NameTooLong:
+                    return "NameTooLong";
+                case GreeterError::Away:
+                    return "Away";
+                case GreeterError::GreetingOtherVisitor:
+                    return "GreetingOtherVisitor";
+            }
+        }
+        return exception.ice_id();
+    }
+
+    /// The ErrorMetricsMiddleware records the reply status of each dispatch in an ErrorCounters object, and the label
+    /// of each user exception.
+    class ErrorMetricsMiddleware final : public Ice::Object
+    {
+    public:
+        /// Constructs an ErrorMetricsMiddleware.
+        /// @param next The next Ice::Object in the dispatch pipeline.
+        /// @param counters The counters that record the replies.
+        /// @param classifier Labels the user exceptions thrown by the servants. A user exception that an AMD servant
+        /// passes to its exception callback doesn't go through the middleware: it's labeled with the UserExceptionLabel
+        /// set by the servant, or with its type ID.
+        ErrorMetricsMiddleware(
+            Ice::ObjectPtr next,
+            std::shared_ptr<ErrorCounters> counters,
+            UserExceptionClassifier classifier);
+
+        // Reimplements the dispatch function provided by Ice::Object.
+        void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
+
+    private:
+        const Ice::ObjectPtr _next;
+        const std::shared_ptr<ErrorCounters> _counters;
+        const UserExceptionClassifier _classifier;
+    };
+}
+
+#endif
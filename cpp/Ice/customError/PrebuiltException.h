@@ -0,0 +1,37 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef PREBUILT_EXCEPTION_H
+#define PREBUILT_EXCEPTION_H
+
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace ServerAMD
+{
+    /// PrebuiltException holds an exception created once, and completes many asynchronous dispatches with this
+    /// exception. A servant that throws an exception allocates a new exception object (typically with a new message)
+    /// and unwinds the stack for each error. An AMD servant can instead pass a PrebuiltException to the exception
+    /// callback of the dispatch: all the responses share the same exception object, with no per-request allocation, and
+    /// no exception thrown in the servant. Ice still rethrows the exception once per response to marshal it.
+    class PrebuiltException
+    {
+    public:
+        /// Constructs a PrebuiltException.
+        /// @param exception The exception. All the responses share this exception, so it must not depend on the
+        /// request.
+        template<typename E>
+        explicit PrebuiltException(E exception) : _exception{std::make_exception_ptr(std::move(exception))}
+        {
+        }
+
+        /// Completes a dispatch with this exception.
+        /// @param exception The exception callback of the dispatch.
+        void reject(const std::function<void(std::exception_ptr)>& exception) const { exception(_exception); }
+
+    private:
+        const std::exception_ptr _exception;
+    };
+}
+
+#endif
@@ -1,6 +1,8 @@
 // Copyright (c) ZeroC, Inc.
 
 #include "Chatbot.h"
+#include "ErrorMetricsAdmin.h"
+#include "ErrorMetricsMiddleware.h"
 
 #include <Ice/Ice.h>
 #include <iostream>
@@ -14,8 +16,18 @@ main(int argc, char* argv[])
     // of the program, before creating an Ice communicator or starting any thread.
     Ice::CtrlCHandler ctrlCHandler;
 
+    // Enable the Ice.Admin object, which provides the error metrics of the server through its ErrorMetrics facet,
+    // unless the command line configures Ice.Admin. This admin endpoint only accepts connections from the local host.
+    Ice::InitializationData initData;
+    initData.properties = Ice::createProperties(argc, argv);
+    if (initData.properties->getIceProperty("Ice.Admin.Endpoints").empty())
+    {
+        initData.properties->setProperty("Ice.Admin.Endpoints", "tcp -h localhost -p 4062");
+        initData.properties->setProperty("Ice.Admin.InstanceName", "customError");
+    }
+
     // Create an Ice communicator. We'll use this communicator to create an object adapter.
-    Ice::CommunicatorPtr communicator = Ice::initialize(argc, argv);
+    Ice::CommunicatorPtr communicator = Ice::initialize(initData);
 
     // Make sure the communicator is destroyed at the end of this scope.
     Ice::CommunicatorHolder communicatorHolder{communicator};
@@ -23,6 +35,21 @@ main(int argc, char* argv[])
     // Create an object adapter that listens for incoming requests and dispatches them to servants.
     auto adapter = communicator->createObjectAdapterWithEndpoints("GreeterAdapter", "tcp -p 4061");
 
+    // Install the ErrorMetrics middleware in the object adapter. It counts the replies of the greet operation by reply
+    // status, and the GreeterExceptions by error code.
+    auto errorCounters = make_shared<Server::ErrorCounters>(
+        vector<string>{"greet"},
+        vector<string>{"NameTooLong", "Away", "GreetingOtherVisitor", "::VisitorCenter::GreeterException"});
+    adapter->use(
+        [errorCounters](Ice::ObjectPtr next)
+        {
+            return make_shared<Server::ErrorMetricsMiddleware>(
+                std::move(next),
+                errorCounters,
+                Server::classifyGreeterException<VisitorCenter::GreeterException>);
+        });
+    communicator->addAdminFacet(make_shared<Server::ErrorMetricsAdmin>(errorCounters), "ErrorMetrics");
+
     // Register the Chatbot servant with the adapter.
     adapter->add(make_shared<Server::Chatbot>(), Ice::Identity{"greeter"});
 
@@ -0,0 +1,72 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ChatbotAMD.h"
+#include "ErrorMetricsAdmin.h"
+#include "ErrorMetricsMiddleware.h"
+
+#include <Ice/Ice.h>
+#include <iostream>
+
+using namespace std;
+
+int
+main(int argc, char* argv[])
+{
+    // CtrlCHandler is a helper class that handles Ctrl+C and similar signals. It must be constructed at the beginning
+    // of the program, before creating an Ice communicator or starting any thread.
+    Ice::CtrlCHandler ctrlCHandler;
+
+    // Enable the Ice.Admin object, which provides the error metrics of the server through its ErrorMetrics facet,
+    // unless the command line configures Ice.Admin. This admin endpoint only accepts connections from the local host.
+    Ice::InitializationData initData;
+    initData.properties = Ice::createProperties(argc, argv);
+    if (initData.properties->getIceProperty("Ice.Admin.Endpoints").empty())
+    {
+        initData.properties->setProperty("Ice.Admin.Endpoints", "tcp -h localhost -p 4062");
+        initData.properties->setProperty("Ice.Admin.InstanceName", "customError");
+    }
+
+    // Create an Ice communicator. We'll use this communicator to create an object adapter.
+    Ice::CommunicatorPtr communicator = Ice::initialize(initData);
+
+    // Make sure the communicator is destroyed at the end of this scope.
+    Ice::CommunicatorHolder communicatorHolder{communicator};
+
+    // Create an object adapter that listens for incoming requests and dispatches them to servants.
+    auto adapter = communicator->createObjectAdapterWithEndpoints("GreeterAdapter", "tcp -p 4061");
+
+    // Install the ErrorMetrics middleware in the object adapter. It counts the replies of the greet operation by reply
+    // status, and the GreeterExceptions by error code.
+    auto errorCounters = make_shared<Server::ErrorCounters>(
+        vector<string>{"greet"},
+        vector<string>{"NameTooLong", "Away", "GreetingOtherVisitor", "::VisitorCenter::GreeterException"});
+    adapter->use(
+        [errorCounters](Ice::ObjectPtr next)
+        {
+            return make_shared<Server::ErrorMetricsMiddleware>(
+                std::move(next),
+                errorCounters,
+                Server::classifyGreeterException<VisitorCenter::GreeterException>);
+        });
+    communicator->addAdminFacet(make_shared<Server::ErrorMetricsAdmin>(errorCounters), "ErrorMetrics");
+
+    // Register the Chatbot servant with the adapter.
+    adapter->add(make_shared<ServerAMD::Chatbot>(), Ice::Identity{"greeter"});
+
+    // Start dispatching requests.
+    adapter->activate();
+    cout << "Listening on port 4061..." << endl;
+
+    // Shut down the communicator when the user presses Ctrl+C.
+    ctrlCHandler.setCallback(
+        [communicator](int signal)
+        {
+            cout << "Caught signal " << signal << ", shutting down..." << endl;
+            communicator->shutdown();
+        });
+
+    // Wait until the communicator is shut down. Here, this occurs when the user presses Ctrl+C.
+    communicator->waitForShutdown();
+
+    return 0;
+}
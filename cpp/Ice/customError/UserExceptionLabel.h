@@ -0,0 +1,42 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef USER_EXCEPTION_LABEL_H
+#define USER_EXCEPTION_LABEL_H
+
+#include <string_view>
+
+namespace Server
+{
+    /// UserExceptionLabel labels the user exception that an AMD servant passes to the exception callback of a dispatch.
+    /// The ErrorMetricsMiddleware only sees the marshaled reply of such an exception, so it can't classify it: it
+    /// records this label instead. Ice marshals and sends the reply in the thread that calls the exception callback,
+    /// so the servant creates a UserExceptionLabel on the stack of this thread, around the call.
+    class UserExceptionLabel final
+    {
+    public:
+        /// Sets the label of the user exceptions sent by the calling thread, until this object is destroyed.
+        /// @param label The label. It must outlive this object.
+        explicit UserExceptionLabel(std::string_view label) noexcept : _previous{current()} { current() = label; }
+
+        /// Restores the previous label of the calling thread.
+        ~UserExceptionLabel() { current() = _previous; }
+
+        UserExceptionLabel(const UserExceptionLabel&) = delete;
+        UserExceptionLabel& operator=(const UserExceptionLabel&) = delete;
+
+        /// Gets the label of the user exceptions sent by the calling thread.
+        /// @return The label, or an empty string if the calling thread didn't set a label.
+        static std::string_view get() noexcept { return current(); }
+
+    private:
+        static std::string_view& current() noexcept
+        {
+            thread_local std::string_view label;
+            return label;
+        }
+
+        const std::string_view _previous;
+    };
+}
+
+#endif
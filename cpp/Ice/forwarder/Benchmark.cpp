@@ -0,0 +1,158 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "Forwarder.h"
+
+#include <Ice/Ice.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    /// Echo is an Ice servant that returns the encapsulation it receives as-is. Like the Forwarder, it does not use
+    /// any Slice generated code.
+    class Echo final : public Ice::Object
+    {
+    public:
+        void dispatch(Ice::IncomingRequest& request, function<void(Ice::OutgoingResponse)> sendResponse) final
+        {
+            const std::byte* inEncapsulationStart = nullptr;
+            int32_t inEncapsulationSize = 0;
+            request.inputStream().readEncapsulation(inEncapsulationStart, inEncapsulationSize);
+            sendResponse(Ice::makeOutgoingResponse(
+                true,
+                make_pair(inEncapsulationStart, inEncapsulationStart + inEncapsulationSize),
+                request.current()));
+        }
+    };
+
+    /// The results of a benchmark run for a given target and payload size.
+    struct Result
+    {
+        double requestsPerSecond;
+        double megabytesPerSecond;
+        chrono::microseconds p50;
+        chrono::microseconds p99;
+    };
+
+    /// Sends iterations echo requests with the given encapsulation to target and measures the round-trip time of each
+    /// request.
+    Result run(const Ice::ObjectPrx& target, const vector<std::byte>& inEncapsulation, size_t iterations)
+    {
+        vector<std::byte> outEncapsulation;
+
+        // Warm up the connection and the thread pools.
+        for (int i = 0; i < 10; ++i)
+        {
+            target->ice_invoke("echo", Ice::OperationMode::Normal, inEncapsulation, outEncapsulation);
+        }
+
+        vector<chrono::nanoseconds> latencies;
+        latencies.reserve(iterations);
+
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            auto requestStart = chrono::steady_clock::now();
+            target->ice_invoke("echo", Ice::OperationMode::Normal, inEncapsulation, outEncapsulation);
+            latencies.push_back(chrono::steady_clock::now() - requestStart);
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p)
+        {
+            auto index = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1));
+            return chrono::duration_cast<chrono::microseconds>(latencies[index]);
+        };
+
+        double requestsPerSecond = static_cast<double>(iterations) / elapsed.count();
+
+        // Each echo request carries the payload twice: once in the request and once in the response.
+        double megabytesPerSecond =
+            requestsPerSecond * 2.0 * static_cast<double>(inEncapsulation.size()) / (1024.0 * 1024.0);
+
+        return {requestsPerSecond, megabytesPerSecond, percentile(0.5), percentile(0.99)};
+    }
+
+    void printResult(const char* label, const Result& result)
+    {
+        cout << "  " << left << setw(10) << label << right << fixed << setprecision(0) << setw(10)
+             << result.requestsPerSecond << " req/s" << setprecision(1) << setw(10) << result.megabytesPerSecond
+             << " MB/s" << setw(8) << result.p50.count() << " us p50" << setw(8) << result.p99.count() << " us p99"
+             << endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    // All three communicators accept messages up to 16 MB, since the largest payload is 4 MB.
+    Ice::InitializationData initData;
+    initData.properties = Ice::createProperties(argc, argv);
+    initData.properties->setProperty("Ice.MessageSizeMax", "16384");
+
+    // We use a separate communicator for the echo server, the forwarding server and the client. This way, all requests
+    // go through the loopback interface, as they would with three separate processes.
+    Ice::CommunicatorHolder backend{Ice::initialize(initData)};
+    Ice::CommunicatorHolder forwarder{Ice::initialize(initData)};
+    Ice::CommunicatorHolder client{Ice::initialize(initData)};
+
+    // Start the echo server on a system-assigned port.
+    auto echoAdapter = backend->createObjectAdapterWithEndpoints("EchoAdapter", "tcp -h localhost -p 0");
+    Ice::ObjectPrx echo = echoAdapter->add(make_shared<Echo>(), Ice::Identity{"echo"});
+    echoAdapter->activate();
+
+    // Start the forwarding server, which forwards all requests to the echo server.
+    auto stats = make_shared<ForwardingServer::ForwarderStats>();
+    auto forwarderAdapter = forwarder->createObjectAdapterWithEndpoints("ForwarderAdapter", "tcp -h localhost -p 0");
+    forwarderAdapter->addDefaultServant(
+        make_shared<ForwardingServer::Forwarder>(Ice::ObjectPrx{forwarder.communicator(), echo->ice_toString()}, stats),
+        "");
+    forwarderAdapter->activate();
+
+    // Create the client proxies. The client communicator doesn't share any connection with the servers.
+    Ice::ObjectPrx direct{client.communicator(), echo->ice_toString()};
+    Ice::ObjectPrx forwarded{
+        client.communicator(),
+        forwarderAdapter->createProxy(Ice::Identity{"echo"})->ice_toString()};
+
+    cout << "Comparing direct and forwarded echo requests over the loopback interface..." << endl;
+
+    const vector<size_t> payloadSizes{16, 256, 4 * 1024, 64 * 1024, 1024 * 1024, 4 * 1024 * 1024};
+    for (size_t payloadSize : payloadSizes)
+    {
+        // Marshal the payload as a sequence<byte> in an encapsulation, as a generated proxy would.
+        vector<std::byte> inEncapsulation;
+        {
+            Ice::OutputStream outputStream{client.communicator()};
+            outputStream.startEncapsulation();
+            outputStream.write(vector<std::byte>(payloadSize, std::byte{0x2a}));
+            outputStream.endEncapsulation();
+            outputStream.finished(inEncapsulation);
+        }
+
+        // Send fewer requests for large payloads, so that each run transfers at most about 256 MB.
+        size_t iterations = clamp<size_t>(256 * 1024 * 1024 / payloadSize, 50, 20000);
+
+        cout << endl << "Payload: " << payloadSize << " bytes, " << iterations << " requests" << endl;
+        printResult("direct", run(direct, inEncapsulation, iterations));
+
+        uint64_t requestsBefore = stats->requests.load();
+        uint64_t bytesForwardedBefore = stats->bytesForwarded.load();
+
+        printResult("forwarded", run(forwarded, inEncapsulation, iterations));
+
+        uint64_t requests = stats->requests.load() - requestsBefore;
+        uint64_t bytesForwarded = stats->bytesForwarded.load() - bytesForwardedBefore;
+        cout << "  encapsulation bytes forwarded per request, both directions: "
+             << (requests > 0 ? bytesForwarded / requests : 0) << endl;
+    }
+
+    return 0;
+}
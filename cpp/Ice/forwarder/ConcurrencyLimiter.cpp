@@ -0,0 +1,102 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ConcurrencyLimiter.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+ForwardingServer::ConcurrencyLimiter::ConcurrencyLimiter(
+    size_t initialLimit,
+    size_t minLimit,
+    size_t maxLimit,
+    chrono::milliseconds targetLatency,
+    size_t maxQueueSize)
+    : _minLimit{static_cast<double>(max<size_t>(minLimit, 1))},
+      _maxLimit{static_cast<double>(max(maxLimit, max<size_t>(minLimit, 1)))},
+      _targetLatency{targetLatency},
+      _maxQueueSize{maxQueueSize},
+      _limit{clamp(static_cast<double>(initialLimit), _minLimit, _maxLimit)}
+{
+}
+
+bool
+ForwardingServer::ConcurrencyLimiter::tryAcquire()
+{
+    const lock_guard<mutex> lock(_mutex);
+    if (static_cast<double>(_inFlight) < _limit)
+    {
+        ++_inFlight;
+        return true;
+    }
+    return false;
+}
+
+bool
+ForwardingServer::ConcurrencyLimiter::enqueue(function<void()> start)
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        if (static_cast<double>(_inFlight) >= _limit)
+        {
+            if (_queue.size() >= _maxQueueSize)
+            {
+                return false;
+            }
+            _queue.push_back(std::move(start));
+            return true;
+        }
+        ++_inFlight;
+    }
+
+    // A slot became available since the caller's tryAcquire; start the call now.
+    start();
+    return true;
+}
+
+void
+ForwardingServer::ConcurrencyLimiter::release(chrono::steady_clock::duration latency, bool failed)
+{
+    vector<function<void()>> ready;
+    {
+        const lock_guard<mutex> lock(_mutex);
+        --_inFlight;
+
+        if (failed || latency > _targetLatency)
+        {
+            auto now = chrono::steady_clock::now();
+            if (now - _lastDecrease > _targetLatency)
+            {
+                _limit = max(_minLimit, _limit * 0.9);
+                _lastDecrease = now;
+            }
+        }
+        else
+        {
+            // Grows the limit by about 1 per window of _limit successful calls.
+            _limit = min(_maxLimit, _limit + 1.0 / _limit);
+        }
+
+        // Start as many queued calls as the new limit allows.
+        while (!_queue.empty() && static_cast<double>(_inFlight) < _limit)
+        {
+            ++_inFlight;
+            ready.push_back(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+    }
+
+    // Start the calls outside the lock, since start can call back into release.
+    for (auto& start : ready)
+    {
+        start();
+    }
+}
+
+size_t
+ForwardingServer::ConcurrencyLimiter::limit() const
+{
+    const lock_guard<mutex> lock(_mutex);
+    return static_cast<size_t>(_limit);
+}
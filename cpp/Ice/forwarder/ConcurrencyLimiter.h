@@ -0,0 +1,69 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef CONCURRENCY_LIMITER_H
+#define CONCURRENCY_LIMITER_H
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace ForwardingServer
+{
+    /// ConcurrencyLimiter limits the number of outstanding calls to a backend. The limit adapts to the latency of the
+    /// backend using AIMD (additive increase, multiplicative decrease): it grows by about 1 each time a full window of
+    /// calls completes within the target latency, and shrinks by 10% when a call is slower than the target or fails.
+    /// Calls that exceed the limit wait in a bounded queue; when this queue is full, new calls are rejected.
+    class ConcurrencyLimiter final
+    {
+    public:
+        /// Constructs a ConcurrencyLimiter.
+        /// @param initialLimit The initial limit on outstanding calls.
+        /// @param minLimit The lower bound for the limit.
+        /// @param maxLimit The upper bound for the limit.
+        /// @param targetLatency A call that takes longer than this latency shrinks the limit.
+        /// @param maxQueueSize The maximum number of calls waiting for a slot.
+        ConcurrencyLimiter(
+            std::size_t initialLimit,
+            std::size_t minLimit,
+            std::size_t maxLimit,
+            std::chrono::milliseconds targetLatency,
+            std::size_t maxQueueSize);
+
+        /// Takes a slot if the number of outstanding calls is below the limit.
+        /// @return true if the caller got a slot and must call release when its call completes, false otherwise.
+        bool tryAcquire();
+
+        /// Queues a call until a slot becomes available. If a slot is already available, start is called immediately.
+        /// @param start The function that starts the call. It's called with a slot, and must eventually call release.
+        /// @return true if start was called or queued, false if the queue is full and the call is rejected.
+        bool enqueue(std::function<void()> start);
+
+        /// Releases a slot taken by tryAcquire or enqueue, and adjusts the limit.
+        /// @param latency The time it took to complete the call.
+        /// @param failed true if the call failed with a local exception such as a timeout, false otherwise.
+        void release(std::chrono::steady_clock::duration latency, bool failed);
+
+        /// Gets the current limit.
+        /// @return The current limit on outstanding calls.
+        std::size_t limit() const;
+
+    private:
+        const double _minLimit;
+        const double _maxLimit;
+        const std::chrono::steady_clock::duration _targetLatency;
+        const std::size_t _maxQueueSize;
+
+        mutable std::mutex _mutex;
+        double _limit;
+        std::size_t _inFlight{0};
+        std::deque<std::function<void()>> _queue;
+
+        // When the limit was last decreased. We decrease at most once per target latency period, so that a burst of
+        // slow calls started under the old limit doesn't collapse the limit.
+        std::chrono::steady_clock::time_point _lastDecrease;
+    };
+}
+
+#endif
@@ -2,9 +2,92 @@
 
 #include "Forwarder.h"
 
+#include <chrono>
+#include <vector>
+
 using namespace std;
 
-ForwardingServer::Forwarder::Forwarder(Ice::ObjectPrx targetTemplate) : _targetTemplate{std::move(targetTemplate)} {}
+namespace
+{
+    // Forwards a request to target. When limiter is set, the request holds a slot, which is released when the
+    // invocation completes.
+    void forward(
+        const Ice::ObjectPrx& target,
+        pair<const std::byte*, const std::byte*> inEncapsulation,
+        const Ice::Current& current,
+        const function<void(Ice::OutgoingResponse)>& sendResponse,
+        const shared_ptr<ForwardingServer::ForwarderStats>& stats,
+        const shared_ptr<ForwardingServer::ConcurrencyLimiter>& limiter)
+    {
+        auto start = chrono::steady_clock::now();
+        try
+        {
+            // Make the invocation asynchronously. This call reports most exceptions through its exception callback.
+            target.ice_invokeAsync(
+                current.operation,
+                current.mode,
+                inEncapsulation,
+                [sendResponse, current, stats, limiter, start](
+                    bool ok,
+                    pair<const std::byte*, const std::byte*> outEncapsulation)
+                {
+                    // The response callback is executed by a thread from the Ice client thread pool when the
+                    // invocation completes successfully (ok is true) or with a user exception (ok is false).
+                    if (limiter)
+                    {
+                        limiter->release(chrono::steady_clock::now() - start, false);
+                    }
+
+                    // outEncapsulation is a view into the buffer of the response received from the target; it is
+                    // marshaled directly into the OutgoingResponse.
+                    if (stats)
+                    {
+                        stats->bytesForwarded.fetch_add(
+                            static_cast<uint64_t>(outEncapsulation.second - outEncapsulation.first),
+                            memory_order_relaxed);
+                    }
+
+                    // We create an OutgoingResponse object and send it back to the client with sendResponse.
+                    sendResponse(Ice::makeOutgoingResponse(ok, outEncapsulation, current));
+                },
+                [sendResponse, current, limiter, start](std::exception_ptr exceptionPtr)
+                {
+                    // The exception callback.
+                    if (limiter)
+                    {
+                        limiter->release(chrono::steady_clock::now() - start, true);
+                    }
+
+                    // We create an OutgoingResponse object with the exception and send it back to the client with
+                    // sendResponse. If the exception is an Ice local exception that cannot be marshaled, such as
+                    // Ice::ConnectionRefusedException, makeOutgoingResponse marshals an Ice::UnknownLocalException.
+                    sendResponse(Ice::makeOutgoingResponse(exceptionPtr, current));
+                },
+                nullptr, // no sent callback
+                current.ctx);
+        }
+        catch (...)
+        {
+            // ice_invokeAsync can throw synchronously, for example when the communicator is destroyed. We release our
+            // slot and report the exception to the client.
+            if (limiter)
+            {
+                limiter->release(chrono::steady_clock::now() - start, true);
+            }
+            sendResponse(Ice::makeOutgoingResponse(current_exception(), current));
+        }
+    }
+}
+
+ForwardingServer::Forwarder::Forwarder(
+    Ice::ObjectPrx targetTemplate,
+    shared_ptr<ForwarderStats> stats,
+    shared_ptr<ConcurrencyLimiter> limiter)
+    : _targetTemplate{std::move(targetTemplate)},
+      _stats{std::move(stats)},
+      _limiter{std::move(limiter)}
+{
+}
 
 void
 ForwardingServer::Forwarder::dispatch(Ice::IncomingRequest& request, function<void(Ice::OutgoingResponse)> sendResponse)
@@ -25,27 +108,49 @@ ForwardingServer::Forwarder::dispatch(Ice::IncomingRequest& request, function<vo
     const std::byte* inEncapsulationStart = nullptr;
     int32_t inEncapsulationSize = 0;
     request.inputStream().readEncapsulation(inEncapsulationStart, inEncapsulationSize);
+    auto inEncapsulation = make_pair(inEncapsulationStart, inEncapsulationStart + inEncapsulationSize);
 
-    // Make the invocation asynchronously. This call reports most exceptions through its exception callback.
-    target.ice_invokeAsync(
-        current.operation,
-        current.mode,
-        make_pair(inEncapsulationStart, inEncapsulationStart + inEncapsulationSize),
-        [sendResponse, current](bool ok, pair<const std::byte*, const std::byte*> outEncapsulation)
+    if (_stats)
+    {
+        // readEncapsulation returns a view into the buffer of the incoming request: the in-parameters are copied
+        // once, when ice_invokeAsync marshals them into the outgoing request.
+        _stats->requests.fetch_add(1, memory_order_relaxed);
+        _stats->bytesForwarded.fetch_add(static_cast<uint64_t>(inEncapsulationSize), memory_order_relaxed);
+    }
+
+    if (!_limiter || _limiter->tryAcquire())
+    {
+        forward(target, inEncapsulation, current, sendResponse, _stats, _limiter);
+        return;
+    }
+
+    // The backend is at its concurrency limit. The request buffer is only valid until dispatch returns, so we copy
+    // the in-parameters before queuing the request.
+    auto inParams = make_shared<vector<std::byte>>(inEncapsulation.first, inEncapsulation.second);
+    bool queued = _limiter->enqueue(
+        [target, inParams, current, sendResponse, stats = _stats, limiter = _limiter]()
         {
-            // The response callback is executed by a thread from the Ice client thread pool when the invocation
-            // completes successfully (ok is true) or with a user exception (ok is false).
-            // We create an OutgoingResponse object and send it back to the client with sendResponse.
-            sendResponse(Ice::makeOutgoingResponse(ok, outEncapsulation, current));
-        },
-        [sendResponse, current](std::exception_ptr exceptionPtr)
+            forward(
+                target,
+                make_pair(inParams->data(), inParams->data() + inParams->size()),
+                current,
+                sendResponse,
+                stats,
+                limiter);
+        });
+
+    if (!queued)
+    {
+        // The queue is full: reject the request right away rather than letting it wait behind the others.
+        if (_stats)
         {
-            // The exception callback.
-            // We create an OutgoingResponse object with the exception and send it back to the client with
-            // sendResponse. If the exception is an Ice local exception that cannot be marshaled, such as
-            // Ice::ConnectionRefusedException, makeOutgoingResponse marshals an Ice::UnknownLocalException.
-            sendResponse(Ice::makeOutgoingResponse(exceptionPtr, current));
-        },
-        nullptr, // no sent callback
-        current.ctx);
+            _stats->requestsRejected.fetch_add(1, memory_order_relaxed);
+        }
+        throw Ice::DispatchException{__FILE__, __LINE__, Overloaded, "the backend is overloaded"};
+    }
+
+    if (_stats)
+    {
+        _stats->requestsQueued.fetch_add(1, memory_order_relaxed);
+    }
 }
@@ -3,10 +3,37 @@
 #ifndef FORWARDER_H
 #define FORWARDER_H
 
+#include "ConcurrencyLimiter.h"
+
 #include <Ice/Ice.h>
 
+#include <atomic>
+#include <cstdint>
+
 namespace ForwardingServer
 {
+    /// The reply status of the dispatch exception sent back to the client when the Forwarder sheds a request because
+    /// the backend is overloaded. This is a custom reply status: its value is not used by Ice.
+    constexpr Ice::ReplyStatus Overloaded{static_cast<Ice::ReplyStatus>(100)};
+
+    /// Counters updated by a Forwarder for each request it forwards. The forwarding benchmark reports these counters
+    /// together with its latency measurements.
+    struct ForwarderStats
+    {
+        /// The number of requests forwarded.
+        std::atomic<std::uint64_t> requests{0};
+
+        /// The number of encapsulation bytes forwarded, in both directions.
+        std::atomic<std::uint64_t> bytesForwarded{0};
+
+        /// The number of requests queued while the backend was at its concurrency limit. The Forwarder copies the
+        /// in-parameters of each of these requests, since the buffer of the incoming request doesn't outlive dispatch.
+        std::atomic<std::uint64_t> requestsQueued{0};
+
+        /// The number of requests rejected by the concurrency limiter.
+        std::atomic<std::uint64_t> requestsRejected{0};
+    };
+
     /// Forwarder is an Ice servant that implements Ice::Object by forwarding all requests it receives to a remote
     /// Ice object.
     class Forwarder final : public Ice::Object
@@ -14,13 +41,21 @@ namespace ForwardingServer
     public:
         /// Constructs a Forwarder servant.
         /// @param targetTemplate A template for the target proxy.
-        explicit Forwarder(Ice::ObjectPrx targetTemplate);
+        /// @param stats The counters to update for each forwarded request, or nullptr to skip this accounting.
+        /// @param limiter The limiter for outstanding calls to the target, or nullptr to forward all requests
+        /// immediately.
+        explicit Forwarder(
+            Ice::ObjectPrx targetTemplate,
+            std::shared_ptr<ForwarderStats> stats = nullptr,
+            std::shared_ptr<ConcurrencyLimiter> limiter = nullptr);
 
         // Implements the pure virtual function dispatch declared on Ice::Object.
         void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
 
     private:
         Ice::ObjectPrx _targetTemplate;
+        const std::shared_ptr<ForwarderStats> _stats;
+        const std::shared_ptr<ConcurrencyLimiter> _limiter;
     };
 }
 
@@ -3,6 +3,7 @@
 #include "Forwarder.h"
 
 #include <Ice/Ice.h>
+#include <chrono>
 #include <iostream>
 
 using namespace std;
@@ -27,9 +28,13 @@ main(int argc, char* argv[])
     // Create a target proxy template, with a dummy identity.
     Ice::ObjectPrx targetTemplate{communicator, "dummy:tcp -h localhost -p 4061"};
 
+    // Create a concurrency limiter that keeps at most 4 to 256 calls outstanding to the target server, depending on how
+    // fast this server responds. Up to 1,000 requests can wait for a slot; the Forwarder rejects additional requests.
+    auto limiter = make_shared<ForwardingServer::ConcurrencyLimiter>(16, 4, 256, 50ms, 1000);
+
     // Register the Forwarder servant as default servant with the object adapter. The empty category means this default
     // servant receives requests to all Ice objects.
-    adapter->addDefaultServant(make_shared<ForwardingServer::Forwarder>(targetTemplate), "");
+    adapter->addDefaultServant(make_shared<ForwardingServer::Forwarder>(targetTemplate, nullptr, limiter), "");
 
     // Start dispatching requests.
     adapter->activate();
@@ -0,0 +1,88 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "AsyncLogger.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+Server::AsyncLogger::AsyncLogger(uint32_t maxMessagesPerSecond)
+    : _maxMessagesPerSecond{maxMessagesPerSecond},
+      _thread{[this] { run(); }}
+{
+}
+
+Server::AsyncLogger::~AsyncLogger()
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+bool
+Server::AsyncLogger::admit() noexcept
+{
+    int64_t now = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now().time_since_epoch()).count();
+
+    // Start a new window when the second changes. Only the thread that wins the exchange resets the counter.
+    int64_t window = _window.load(memory_order_relaxed);
+    if (window != now && _window.compare_exchange_strong(window, now, memory_order_relaxed))
+    {
+        _admitted.store(0, memory_order_relaxed);
+    }
+
+    if (_admitted.fetch_add(1, memory_order_relaxed) < _maxMessagesPerSecond)
+    {
+        return true;
+    }
+    _dropped.fetch_add(1, memory_order_relaxed);
+    return false;
+}
+
+void
+Server::AsyncLogger::enqueue(string message)
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _queue.push_back(std::move(message));
+    }
+    _condition.notify_one();
+}
+
+void
+Server::AsyncLogger::run()
+{
+    deque<string> messages;
+    while (true)
+    {
+        bool stopped;
+        {
+            unique_lock<mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _stopped || !_queue.empty(); });
+            messages.swap(_queue);
+            stopped = _stopped;
+        }
+
+        // Write the whole batch with a single flush.
+        uint64_t dropped = _dropped.exchange(0, memory_order_relaxed);
+        if (dropped > 0)
+        {
+            cout << "(" << dropped << " log messages dropped)\n";
+        }
+        for (const auto& message : messages)
+        {
+            cout << message << '\n';
+        }
+        cout << flush;
+        messages.clear();
+
+        if (stopped)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Server
+{
+    /// AsyncLogger writes log messages to the standard output from a background thread, so that dispatch threads never
+    /// wait for the console. It admits at most a given number of messages per second; it drops the other messages and
+    /// reports how many it dropped.
+    class AsyncLogger final
+    {
+    public:
+        /// Constructs an AsyncLogger and starts its background thread.
+        /// @param maxMessagesPerSecond The maximum number of messages logged per second.
+        explicit AsyncLogger(std::uint32_t maxMessagesPerSecond);
+
+        /// Writes the remaining messages and stops the background thread.
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        /// Logs a message if the rate limit allows it.
+        /// @param format A function that returns the message. It's only called when the message is admitted, so
+        /// dropped messages cost neither formatting nor allocation.
+        template<typename Format> void log(Format format)
+        {
+            if (admit())
+            {
+                enqueue(format());
+            }
+        }
+
+    private:
+        bool admit() noexcept;
+        void enqueue(std::string message);
+        void run();
+
+        const std::uint32_t _maxMessagesPerSecond;
+
+        // The rate limit window, in seconds since the steady clock's epoch, and the number of messages admitted and
+        // dropped in this window.
+        std::atomic<std::int64_t> _window{0};
+        std::atomic<std::uint32_t> _admitted{0};
+        std::atomic<std::uint64_t> _dropped{0};
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::deque<std::string> _queue;
+        bool _stopped{false};
+        std::thread _thread;
+    };
+}
+
+#endif
@@ -2,13 +2,17 @@
 
 #include "AuthorizationMiddleware.h"
 
-#include <iostream>
+#include <chrono>
 
 using namespace std;
 
-Server::AuthorizationMiddleware::AuthorizationMiddleware(Ice::ObjectPtr next, string validToken)
+Server::AuthorizationMiddleware::AuthorizationMiddleware(
+    Ice::ObjectPtr next,
+    shared_ptr<TokenValidator> validator,
+    shared_ptr<AsyncLogger> logger)
     : _next{std::move(next)},
-      _validToken{std::move(validToken)}
+      _validator{std::move(validator)},
+      _logger{std::move(logger)}
 {
 }
 
@@ -17,20 +21,31 @@ Server::AuthorizationMiddleware::dispatch(
     Ice::IncomingRequest& request,
     function<void(Ice::OutgoingResponse)> sendResponse)
 {
-    // Check if the request has a valid token in its context.
-    auto p = request.current().ctx.find("token");
-    string token = p != request.current().ctx.end() ? p->second : "";
-    if (token != _validToken)
+    static const string noToken;
+
+    // Check if the request has a valid token in its context. We refer to the token in the context; we don't copy it.
+    const Ice::Context& ctx = request.current().ctx;
+    auto p = ctx.find("token");
+    const string& token = p != ctx.end() ? p->second : noToken;
+
+    auto now = chrono::system_clock::now();
+    if (!_cache.contains(token, now))
     {
-        cout << "Rejecting request with invalid token '" << token << "'" << endl;
-        throw Ice::DispatchException{
-            __FILE__,
-            __LINE__,
-            Ice::ReplyStatus::Unauthorized,
-            "Invalid token '" + token + "'"};
+        // Not validated yet, or expired: ask the validator, and cache the token if it's valid.
+        optional<chrono::system_clock::time_point> expiration = _validator->validate(token);
+        if (!expiration)
+        {
+            _logger->log([&token] { return "Rejecting request with invalid token '" + token + "'"; });
+            throw Ice::DispatchException{
+                __FILE__,
+                __LINE__,
+                Ice::ReplyStatus::Unauthorized,
+                "Invalid token '" + token + "'"};
+        }
+        _cache.add(token, *expiration);
     }
 
-    cout << "Accepting request with token '" << token << "'" << endl;
+    _logger->log([&token] { return "Accepting request with token '" + token + "'"; });
 
     // Continue the dispatch pipeline.
     _next->dispatch(request, std::move(sendResponse));
@@ -3,6 +3,10 @@
 #ifndef AUTHORIZATION_MIDDLEWARE_H
 #define AUTHORIZATION_MIDDLEWARE_H
 
+#include "AsyncLogger.h"
+#include "TokenCache.h"
+#include "TokenValidator.h"
+
 #include <Ice/Ice.h>
 
 namespace Server
@@ -13,15 +17,21 @@ namespace Server
     public:
         /// Constructs an AuthorizationMiddleware.
         /// @param next The next Ice::Object in the dispatch pipeline.
-        /// @param validToken The value to check against.
-        AuthorizationMiddleware(Ice::ObjectPtr next, std::string validToken);
+        /// @param validator The validator for the tokens. The middleware caches the tokens it validates.
+        /// @param logger The logger for accepted and rejected requests.
+        AuthorizationMiddleware(
+            Ice::ObjectPtr next,
+            std::shared_ptr<TokenValidator> validator,
+            std::shared_ptr<AsyncLogger> logger);
 
         // Reimplements the dispatch function provided by Ice::Object.
         void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
 
     private:
         const Ice::ObjectPtr _next;
-        const std::string _validToken;
+        const std::shared_ptr<TokenValidator> _validator;
+        const std::shared_ptr<AsyncLogger> _logger;
+        TokenCache _cache{1024};
     };
 }
 
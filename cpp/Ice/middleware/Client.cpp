@@ -2,8 +2,14 @@
 
 #include "../../common/Env.h"
 #include "Greeter.h"
+#include "HmacToken.h"
+#include "Metrics.h"
+#include "RequestTimestamp.h"
+#include "TraceContext.h"
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 using namespace std;
 
@@ -20,9 +26,9 @@ main(int argc, char* argv[])
     // the server's hostname or IP address.
     VisitorCenter::GreeterPrx greeter{communicator, "greeter:tcp -h localhost -p 4061"};
 
-    // We hardcode the tokens in this demo, for simplicity. A real application would obtain the token from a secure
-    // source.
-    const string validToken = "iced tea";
+    // We sign our own token with a secret shared with the server, and hardcode this secret in this demo, for
+    // simplicity. A real application would obtain the token from a secure source. This token is valid for one hour.
+    const string validToken = HmacToken::create("iced tea", Env::getUsername(), chrono::system_clock::now() + 1h);
 
     // Send a request to the remote object with an invalid token in the request context.
     try
@@ -40,9 +46,44 @@ main(int argc, char* argv[])
         }
     }
 
-    // Send a request with the correct token in the request context.
-    string greeting = greeter.greet(Env::getUsername(), {{"token", validToken}});
+    // Send a request with the correct token in the request context. We also start a new trace, sampled, and add its
+    // trace context to the request context: the server records its dispatch of this request as a child span.
+    // Finally, we stamp the request with the time we send it, so that the server can measure how long the request
+    // waited before its dispatch.
+    Ice::Context context{{"token", validToken}};
+    Tracing::TraceContext::createRoot(true).inject(context);
+    RequestTimestamp::stamp(context);
+    string greeting = greeter.greet(Env::getUsername(), context);
     cout << greeting << endl;
 
+    // Send a burst of 20 requests. The server lets each client send bursts of up to 10 requests, and rejects the others
+    // with a dispatch exception that carries a custom reply status (100 = too many requests). See RateLimitMiddleware.
+    int throttled = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        try
+        {
+            Ice::Context burstContext{{"token", validToken}};
+            RequestTimestamp::stamp(burstContext);
+            greeter.greet(Env::getUsername(), burstContext);
+        }
+        catch (const Ice::DispatchException& dispatchException)
+        {
+            if (dispatchException.replyStatus() != static_cast<Ice::ReplyStatus>(100))
+            {
+                throw;
+            }
+            ++throttled;
+        }
+    }
+    cout << "The server throttled " << throttled << " of 20 requests." << endl;
+
+    // Wait for the server to let us send requests again.
+    this_thread::sleep_for(1s);
+
+    // Retrieve the dispatch metrics collected by the server's Metrics middleware.
+    Diagnostics::MetricsPrx metrics{communicator, "metrics:tcp -h localhost -p 4061"};
+    cout << metrics.dump(Diagnostics::MetricsFormat::Text, {{"token", validToken}});
+
     return 0;
 }
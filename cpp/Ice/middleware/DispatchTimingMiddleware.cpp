@@ -0,0 +1,48 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "DispatchTimingMiddleware.h"
+#include "RequestTimestamp.h"
+
+#include <chrono>
+
+using namespace std;
+
+Server::DispatchTimingMiddleware::DispatchTimingMiddleware(Ice::ObjectPtr next, shared_ptr<AdapterTimings> timings)
+    : _next{std::move(next)},
+      _timings{std::move(timings)}
+{
+}
+
+void
+Server::DispatchTimingMiddleware::dispatch(
+    Ice::IncomingRequest& request,
+    function<void(Ice::OutgoingResponse)> sendResponse)
+{
+    auto dispatchStart = chrono::steady_clock::now();
+
+    if (auto sentAt = RequestTimestamp::read(request.current().ctx))
+    {
+        _timings->queueWait.recordConcurrent(chrono::system_clock::now() - *sentAt);
+    }
+    else
+    {
+        _timings->unstamped.fetch_add(1, memory_order_relaxed);
+    }
+
+    try
+    {
+        _next->dispatch(
+            request,
+            [sendResponse = std::move(sendResponse), timings = _timings, dispatchStart](Ice::OutgoingResponse response)
+            {
+                timings->serviceTime.recordConcurrent(chrono::steady_clock::now() - dispatchStart);
+                sendResponse(std::move(response));
+            });
+    }
+    catch (...)
+    {
+        // The dispatch failed synchronously; Ice sends the response as soon as we rethrow.
+        _timings->serviceTime.recordConcurrent(chrono::steady_clock::now() - dispatchStart);
+        throw;
+    }
+}
@@ -0,0 +1,32 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef DISPATCH_TIMING_MIDDLEWARE_H
+#define DISPATCH_TIMING_MIDDLEWARE_H
+
+#include "DispatchTimings.h"
+
+#include <Ice/Ice.h>
+
+namespace Server
+{
+    /// The DispatchTimingMiddleware measures how long each request waited before its dispatch started (queue wait),
+    /// using the timestamp the client added to the request context, and how long the dispatch took until the response
+    /// was sent (service time).
+    class DispatchTimingMiddleware final : public Ice::Object
+    {
+    public:
+        /// Constructs a DispatchTimingMiddleware.
+        /// @param next The next Ice::Object in the dispatch pipeline.
+        /// @param timings The timings of the object adapter that owns this middleware.
+        DispatchTimingMiddleware(Ice::ObjectPtr next, std::shared_ptr<AdapterTimings> timings);
+
+        // Reimplements the dispatch function provided by Ice::Object.
+        void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
+
+    private:
+        const Ice::ObjectPtr _next;
+        const std::shared_ptr<AdapterTimings> _timings;
+    };
+}
+
+#endif
@@ -0,0 +1,70 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "DispatchTimings.h"
+
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    vector<uint64_t> getBuckets(const Server::LatencyHistogram& histogram)
+    {
+        vector<uint64_t> buckets(Server::LatencyHistogram::BucketCount);
+        histogram.addTo(buckets);
+        return buckets;
+    }
+}
+
+shared_ptr<Server::AdapterTimings>
+Server::DispatchTimings::getAdapterTimings(const string& adapterName)
+{
+    const lock_guard<mutex> lock(_mutex);
+    auto& timings = _adapters[adapterName];
+    if (!timings)
+    {
+        timings = make_shared<AdapterTimings>();
+    }
+    return timings;
+}
+
+string
+Server::DispatchTimings::dumpText() const
+{
+    const lock_guard<mutex> lock(_mutex);
+    ostringstream os;
+    for (const auto& [adapterName, timings] : _adapters)
+    {
+        os << adapterName << " queue wait (us): " << LatencyHistogram::formatText(getBuckets(timings->queueWait))
+           << ", unstamped requests = " << timings->unstamped.load() << "\n";
+        os << adapterName << " service time (us): " << LatencyHistogram::formatText(getBuckets(timings->serviceTime))
+           << "\n";
+    }
+    return os.str();
+}
+
+string
+Server::DispatchTimings::dumpJson() const
+{
+    const lock_guard<mutex> lock(_mutex);
+    ostringstream os;
+    os << "{\"adapters\":[";
+    bool first = true;
+    for (const auto& [adapterName, timings] : _adapters)
+    {
+        if (!first)
+        {
+            os << ",";
+        }
+        first = false;
+
+        // Adapter names are chosen by the server, so they don't need escaping.
+        os << "{\"name\":\"" << adapterName
+           << "\",\"queueWaitNs\":" << LatencyHistogram::formatJson(getBuckets(timings->queueWait))
+           << ",\"serviceTimeNs\":" << LatencyHistogram::formatJson(getBuckets(timings->serviceTime))
+           << ",\"unstamped\":" << timings->unstamped.load() << "}";
+    }
+    os << "]}";
+    return os.str();
+}
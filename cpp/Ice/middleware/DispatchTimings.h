@@ -0,0 +1,54 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef DISPATCH_TIMINGS_H
+#define DISPATCH_TIMINGS_H
+
+#include "MetricsRegistry.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Server
+{
+    /// The dispatch timings of an object adapter.
+    struct AdapterTimings
+    {
+        /// The time between the client sending a request and the start of its dispatch. It includes the time the
+        /// request spent in the network and in socket buffers, waiting for a thread from the server thread pool.
+        LatencyHistogram queueWait;
+
+        /// The time between the start of a dispatch and the sending of its response.
+        LatencyHistogram serviceTime;
+
+        /// The number of requests that didn't carry a timestamp; their queue wait is unknown.
+        std::atomic<std::uint64_t> unstamped{0};
+    };
+
+    /// DispatchTimings holds the dispatch timings of all the object adapters of a server.
+    class DispatchTimings final
+    {
+    public:
+        /// Gets the timings of an object adapter, creating them if needed.
+        /// @param adapterName The name of the object adapter.
+        /// @return The timings of this object adapter.
+        std::shared_ptr<AdapterTimings> getAdapterTimings(const std::string& adapterName);
+
+        /// Dumps the timings as a human-readable text report.
+        /// @return The text report.
+        std::string dumpText() const;
+
+        /// Dumps the timings as a JSON document.
+        /// @return The JSON document.
+        std::string dumpJson() const;
+
+    private:
+        mutable std::mutex _mutex;
+        std::map<std::string, std::shared_ptr<AdapterTimings>> _adapters;
+    };
+}
+
+#endif
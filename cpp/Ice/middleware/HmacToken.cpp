@@ -0,0 +1,101 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "HmacToken.h"
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    using Digest = array<uint8_t, 32>;
+
+    // Computes the HMAC-SHA256 of message with key, with OpenSSL.
+    Digest hmacSha256(string_view key, string_view message)
+    {
+        Digest digest;
+        unsigned int digestSize = 0;
+        if (!HMAC(
+                EVP_sha256(),
+                key.data(),
+                static_cast<int>(key.size()),
+                reinterpret_cast<const unsigned char*>(message.data()),
+                message.size(),
+                digest.data(),
+                &digestSize) ||
+            digestSize != digest.size())
+        {
+            throw runtime_error{"HMAC-SHA256 computation failed"};
+        }
+        return digest;
+    }
+
+    string toHex(const Digest& digest)
+    {
+        const char* hexDigits = "0123456789abcdef";
+        string hex;
+        hex.reserve(digest.size() * 2);
+        for (uint8_t byte : digest)
+        {
+            hex.push_back(hexDigits[byte >> 4]);
+            hex.push_back(hexDigits[byte & 0x0f]);
+        }
+        return hex;
+    }
+
+    // Compares two strings in a time that depends only on their length, so that the comparison of signatures doesn't
+    // reveal how many leading characters match.
+    bool constantTimeEquals(string_view lhs, string_view rhs)
+    {
+        return lhs.size() == rhs.size() && CRYPTO_memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+    }
+}
+
+string
+HmacToken::create(string_view secret, string_view subject, chrono::system_clock::time_point expiration)
+{
+    string payload{subject};
+    payload += ':';
+    payload += to_string(chrono::duration_cast<chrono::seconds>(expiration.time_since_epoch()).count());
+    return payload + ':' + toHex(hmacSha256(secret, payload));
+}
+
+optional<chrono::system_clock::time_point>
+HmacToken::verify(string_view secret, string_view token)
+{
+    size_t signatureStart = token.rfind(':');
+    if (signatureStart == string_view::npos)
+    {
+        return nullopt;
+    }
+    string_view payload = token.substr(0, signatureStart);
+    string_view signature = token.substr(signatureStart + 1);
+
+    size_t expirationStart = payload.rfind(':');
+    if (expirationStart == string_view::npos)
+    {
+        return nullopt;
+    }
+    string_view expirationString = payload.substr(expirationStart + 1);
+
+    int64_t expiration = 0;
+    auto [end, error] =
+        from_chars(expirationString.data(), expirationString.data() + expirationString.size(), expiration);
+    if (error != errc{} || end != expirationString.data() + expirationString.size())
+    {
+        return nullopt;
+    }
+
+    if (!constantTimeEquals(toHex(hmacSha256(secret, payload)), signature))
+    {
+        return nullopt;
+    }
+    return chrono::system_clock::time_point{chrono::seconds{expiration}};
+}
@@ -0,0 +1,32 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef HMAC_TOKEN_H
+#define HMAC_TOKEN_H
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// Signed tokens with an expiration time. A token has the form `subject:expiration:signature`, where expiration is a
+/// number of seconds since the Unix epoch and signature is the hex-encoded HMAC-SHA256 of `subject:expiration` computed
+/// with a secret shared by the token issuer and the token validator.
+namespace HmacToken
+{
+    /// Creates a signed token.
+    /// @param secret The secret used to sign the token.
+    /// @param subject The subject of the token, for example a user name.
+    /// @param expiration The expiration time of the token.
+    /// @return The signed token.
+    std::string
+    create(std::string_view secret, std::string_view subject, std::chrono::system_clock::time_point expiration);
+
+    /// Verifies the signature of a token.
+    /// @param secret The secret used to sign the token.
+    /// @param token The token to verify.
+    /// @return The expiration time of the token if its signature is valid, nullopt otherwise. The caller must check
+    /// whether the token has expired.
+    std::optional<std::chrono::system_clock::time_point> verify(std::string_view secret, std::string_view token);
+}
+
+#endif
@@ -0,0 +1,21 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "MetricsAdmin.h"
+
+using namespace std;
+
+Server::MetricsAdmin::MetricsAdmin(shared_ptr<MetricsRegistry> registry, shared_ptr<DispatchTimings> timings)
+    : _registry{std::move(registry)},
+      _timings{std::move(timings)}
+{
+}
+
+string
+Server::MetricsAdmin::dump(Diagnostics::MetricsFormat format, const Ice::Current&)
+{
+    if (format == Diagnostics::MetricsFormat::Json)
+    {
+        return "{\"dispatches\":" + _registry->dumpJson() + ",\"timings\":" + _timings->dumpJson() + "}";
+    }
+    return _registry->dumpText() + _timings->dumpText();
+}
@@ -0,0 +1,32 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef METRICS_ADMIN_H
+#define METRICS_ADMIN_H
+
+#include "DispatchTimings.h"
+#include "Metrics.h"
+#include "MetricsRegistry.h"
+
+namespace Server
+{
+    /// MetricsAdmin is an Ice servant that implements Slice interface Metrics by dumping a MetricsRegistry and the
+    /// dispatch timings of the server's object adapters.
+    class MetricsAdmin final : public Diagnostics::Metrics
+    {
+    public:
+        /// Constructs a MetricsAdmin servant.
+        /// @param registry The registry to dump.
+        /// @param timings The dispatch timings to dump.
+        MetricsAdmin(std::shared_ptr<MetricsRegistry> registry, std::shared_ptr<DispatchTimings> timings);
+
+        // Implements the pure virtual function in the base class (Diagnostics::Metrics) generated by the Slice
+        // compiler.
+        std::string dump(Diagnostics::MetricsFormat format, const Ice::Current&) final;
+
+    private:
+        const std::shared_ptr<MetricsRegistry> _registry;
+        const std::shared_ptr<DispatchTimings> _timings;
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "MetricsMiddleware.h"
+
+#include <chrono>
+
+using namespace std;
+
+Server::MetricsMiddleware::MetricsMiddleware(Ice::ObjectPtr next, shared_ptr<MetricsRegistry> registry)
+    : _next{std::move(next)},
+      _registry{std::move(registry)}
+{
+}
+
+void
+Server::MetricsMiddleware::dispatch(Ice::IncomingRequest& request, function<void(Ice::OutgoingResponse)> sendResponse)
+{
+    auto start = chrono::steady_clock::now();
+
+    try
+    {
+        // Continue the dispatch pipeline, and record the dispatch when the response is sent. The response carries the
+        // current object of the request, so we don't need to copy the identity or the operation name.
+        _next->dispatch(
+            request,
+            [sendResponse = std::move(sendResponse), registry = _registry, start](Ice::OutgoingResponse response)
+            {
+                registry->record(
+                    response.current().id,
+                    response.current().operation,
+                    response.replyStatus(),
+                    chrono::steady_clock::now() - start);
+                sendResponse(std::move(response));
+            });
+    }
+    catch (const Ice::DispatchException& exception)
+    {
+        // A middleware or servant further down the pipeline can reject the request by throwing an exception; Ice then
+        // creates the response from this exception.
+        _registry->record(
+            request.current().id,
+            request.current().operation,
+            exception.replyStatus(),
+            chrono::steady_clock::now() - start);
+        throw;
+    }
+    catch (const Ice::UserException&)
+    {
+        _registry->record(
+            request.current().id,
+            request.current().operation,
+            Ice::ReplyStatus::UserException,
+            chrono::steady_clock::now() - start);
+        throw;
+    }
+    catch (const Ice::LocalException&)
+    {
+        _registry->record(
+            request.current().id,
+            request.current().operation,
+            Ice::ReplyStatus::UnknownLocalException,
+            chrono::steady_clock::now() - start);
+        throw;
+    }
+    catch (...)
+    {
+        _registry->record(
+            request.current().id,
+            request.current().operation,
+            Ice::ReplyStatus::UnknownException,
+            chrono::steady_clock::now() - start);
+        throw;
+    }
+}
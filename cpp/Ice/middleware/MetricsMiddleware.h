@@ -0,0 +1,30 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef METRICS_MIDDLEWARE_H
+#define METRICS_MIDDLEWARE_H
+
+#include "MetricsRegistry.h"
+
+#include <Ice/Ice.h>
+
+namespace Server
+{
+    /// The MetricsMiddleware measures each dispatch and records its reply status and latency in a MetricsRegistry.
+    class MetricsMiddleware final : public Ice::Object
+    {
+    public:
+        /// Constructs a MetricsMiddleware.
+        /// @param next The next Ice::Object in the dispatch pipeline.
+        /// @param registry The registry that records the dispatch metrics.
+        MetricsMiddleware(Ice::ObjectPtr next, std::shared_ptr<MetricsRegistry> registry);
+
+        // Reimplements the dispatch function provided by Ice::Object.
+        void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
+
+    private:
+        const Ice::ObjectPtr _next;
+        const std::shared_ptr<MetricsRegistry> _registry;
+    };
+}
+
+#endif
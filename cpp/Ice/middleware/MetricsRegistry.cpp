@@ -0,0 +1,395 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "MetricsRegistry.h"
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef _MSC_VER
+#    include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    // Returns the position of the most significant bit set in value, which must not be 0.
+    inline size_t mostSignificantBit(uint64_t value) noexcept
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return static_cast<size_t>(63 - __builtin_clzll(value));
+#endif
+    }
+
+    // Increments a counter that has a single writer. A relaxed load and store is enough and is cheaper than fetch_add.
+    inline void increment(atomic<uint64_t>& counter) noexcept
+    {
+        counter.store(counter.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+
+    // Hashes an (identity, operation) pair.
+    inline size_t hashOperation(const Ice::Identity& id, const string& operation) noexcept
+    {
+        hash<string> hasher;
+        size_t h = hasher(id.name);
+        h ^= hasher(id.category) + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2);
+        h ^= hasher(operation) + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    // Escapes a string for inclusion in a JSON document.
+    string escapeJson(const string& value)
+    {
+        ostringstream os;
+        for (char c : value)
+        {
+            switch (c)
+            {
+                case '"':
+                    os << "\\\"";
+                    break;
+                case '\\':
+                    os << "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        os << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c) << dec;
+                    }
+                    else
+                    {
+                        os << c;
+                    }
+                    break;
+            }
+        }
+        return os.str();
+    }
+
+    string replyStatusName(size_t replyStatus)
+    {
+        if (replyStatus == Server::MetricsRegistry::ReplyStatusCount - 1)
+        {
+            return "Other";
+        }
+        ostringstream os;
+        os << static_cast<Ice::ReplyStatus>(replyStatus);
+        return os.str();
+    }
+
+    // The registries are identified by a unique ID in the thread-local shard maps.
+    atomic<uint64_t> nextRegistryId{0};
+}
+
+void
+Server::LatencyHistogram::record(chrono::nanoseconds latency) noexcept
+{
+    increment(_buckets[bucketIndex(static_cast<uint64_t>(max(latency.count(), chrono::nanoseconds::rep{0})))]);
+}
+
+void
+Server::LatencyHistogram::recordConcurrent(chrono::nanoseconds latency) noexcept
+{
+    _buckets[bucketIndex(static_cast<uint64_t>(max(latency.count(), chrono::nanoseconds::rep{0})))].fetch_add(
+        1,
+        memory_order_relaxed);
+}
+
+void
+Server::LatencyHistogram::addTo(vector<uint64_t>& buckets) const noexcept
+{
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+        buckets[i] += _buckets[i].load(memory_order_relaxed);
+    }
+}
+
+size_t
+Server::LatencyHistogram::bucketIndex(uint64_t value) noexcept
+{
+    if (value < SubBucketCount)
+    {
+        return static_cast<size_t>(value);
+    }
+
+    // Keep the SubBucketBits bits that follow the most significant bit.
+    size_t shift = mostSignificantBit(value) - SubBucketBits;
+    size_t subBucket = static_cast<size_t>(value >> shift) - SubBucketCount;
+    return min((shift + 1) * SubBucketCount + subBucket, BucketCount - 1);
+}
+
+uint64_t
+Server::LatencyHistogram::bucketLowerBound(size_t index) noexcept
+{
+    if (index < SubBucketCount)
+    {
+        return index;
+    }
+    size_t shift = index / SubBucketCount - 1;
+    return static_cast<uint64_t>(SubBucketCount + index % SubBucketCount) << shift;
+}
+
+uint64_t
+Server::LatencyHistogram::percentile(const vector<uint64_t>& buckets, double p) noexcept
+{
+    // The buckets are read while other threads record latencies, so they can be slightly inconsistent with each other.
+    uint64_t total = 0;
+    for (uint64_t bucket : buckets)
+    {
+        total += bucket;
+    }
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    auto rank = min(static_cast<uint64_t>(p * static_cast<double>(total)), total - 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen > rank)
+        {
+            return bucketLowerBound(i);
+        }
+    }
+    return bucketLowerBound(buckets.size() - 1);
+}
+
+string
+Server::LatencyHistogram::formatText(const vector<uint64_t>& buckets)
+{
+    ostringstream os;
+    os << fixed << setprecision(1) << "p50 = " << static_cast<double>(percentile(buckets, 0.5)) / 1000.0
+       << ", p90 = " << static_cast<double>(percentile(buckets, 0.9)) / 1000.0
+       << ", p99 = " << static_cast<double>(percentile(buckets, 0.99)) / 1000.0
+       << ", max bucket = " << static_cast<double>(percentile(buckets, 1.0)) / 1000.0;
+    return os.str();
+}
+
+string
+Server::LatencyHistogram::formatJson(const vector<uint64_t>& buckets)
+{
+    ostringstream os;
+    os << "{\"p50\":" << percentile(buckets, 0.5) << ",\"p90\":" << percentile(buckets, 0.9)
+       << ",\"p99\":" << percentile(buckets, 0.99) << ",\"maxBucket\":" << percentile(buckets, 1.0) << "}";
+    return os.str();
+}
+
+// The metrics of an (identity, operation) pair recorded by a single dispatch thread.
+struct Server::MetricsRegistry::OperationMetrics
+{
+    array<atomic<uint64_t>, ReplyStatusCount> replyStatuses{};
+    LatencyHistogram latency;
+};
+
+// The metrics recorded by a single dispatch thread.
+struct Server::MetricsRegistry::Shard
+{
+    ~Shard()
+    {
+        for (auto& operation : operations)
+        {
+            delete operation.load();
+        }
+    }
+
+    // Written by the owner thread, read by the threads that dump the metrics.
+    array<atomic<OperationMetrics*>, MaxOperations> operations{};
+
+    // Caches the operation indexes by hash. Pairs with the same hash are chained under the same key. Only the owner
+    // thread uses this map.
+    unordered_multimap<size_t, size_t> operationIndexes;
+};
+
+Server::MetricsRegistry::MetricsRegistry()
+    : _id{nextRegistryId++},
+      _operations{new pair<Ice::Identity, string>[MaxOperations]}
+{
+    // Index 0 collects the dispatches to (identity, operation) pairs that don't fit in the registry.
+    _operations[0] = {Ice::Identity{"*"}, "*"};
+    _operationCount = 1;
+}
+
+Server::MetricsRegistry::~MetricsRegistry() = default;
+
+void
+Server::MetricsRegistry::record(
+    const Ice::Identity& id,
+    const string& operation,
+    Ice::ReplyStatus replyStatus,
+    chrono::nanoseconds latency)
+{
+    Shard& shard = localShard();
+    size_t index = operationIndex(shard, id, operation);
+
+    OperationMetrics* metrics = shard.operations[index].load(memory_order_relaxed);
+    if (!metrics)
+    {
+        // First dispatch of this operation on this thread.
+        metrics = new OperationMetrics;
+        shard.operations[index].store(metrics, memory_order_release);
+    }
+
+    increment(metrics->replyStatuses[min(static_cast<size_t>(replyStatus), ReplyStatusCount - 1)]);
+    metrics->latency.record(latency);
+}
+
+Server::MetricsRegistry::Shard&
+Server::MetricsRegistry::localShard()
+{
+    // Each thread keeps the shards it owns, keyed by registry ID.
+    thread_local unordered_map<uint64_t, Shard*> localShards;
+
+    Shard*& shard = localShards[_id];
+    if (!shard)
+    {
+        auto newShard = make_unique<Shard>();
+        shard = newShard.get();
+
+        const lock_guard<mutex> lock(_mutex);
+        _shards.push_back(std::move(newShard));
+    }
+    return *shard;
+}
+
+size_t
+Server::MetricsRegistry::operationIndex(Shard& shard, const Ice::Identity& id, const string& operation)
+{
+    size_t h = hashOperation(id, operation);
+
+    // Fast path: this thread already knows the index.
+    auto range = shard.operationIndexes.equal_range(h);
+    for (auto p = range.first; p != range.second; ++p)
+    {
+        const auto& entry = _operations[p->second];
+        if (entry.first == id && entry.second == operation)
+        {
+            return p->second;
+        }
+    }
+
+    size_t index = 0;
+    {
+        const lock_guard<mutex> lock(_mutex);
+        for (size_t i = 1; i < _operationCount; ++i)
+        {
+            if (_operations[i].first == id && _operations[i].second == operation)
+            {
+                index = i;
+                break;
+            }
+        }
+
+        if (index == 0 && _operationCount < MaxOperations)
+        {
+            index = _operationCount++;
+            _operations[index] = {id, operation};
+        }
+    }
+
+    if (index != 0)
+    {
+        shard.operationIndexes.emplace(h, index);
+    }
+    return index;
+}
+
+vector<Server::MetricsRegistry::Snapshot>
+Server::MetricsRegistry::snapshot() const
+{
+    const lock_guard<mutex> lock(_mutex);
+
+    vector<Snapshot> snapshots;
+    for (size_t i = 0; i < _operationCount; ++i)
+    {
+        Snapshot snapshot;
+        snapshot.id = _operations[i].first;
+        snapshot.operation = _operations[i].second;
+        snapshot.buckets.resize(LatencyHistogram::BucketCount);
+        for (const auto& shard : _shards)
+        {
+            if (const OperationMetrics* metrics = shard->operations[i].load(memory_order_acquire))
+            {
+                for (size_t status = 0; status < ReplyStatusCount; ++status)
+                {
+                    uint64_t count = metrics->replyStatuses[status].load(memory_order_relaxed);
+                    snapshot.replyStatuses[status] += count;
+                    snapshot.count += count;
+                }
+                metrics->latency.addTo(snapshot.buckets);
+            }
+        }
+
+        if (snapshot.count > 0)
+        {
+            snapshots.push_back(std::move(snapshot));
+        }
+    }
+    return snapshots;
+}
+
+string
+Server::MetricsRegistry::dumpText() const
+{
+    ostringstream os;
+    for (const auto& snapshot : snapshot())
+    {
+        os << Ice::identityToString(snapshot.id) << " " << snapshot.operation << ": count = " << snapshot.count;
+        for (size_t status = 0; status < ReplyStatusCount; ++status)
+        {
+            if (snapshot.replyStatuses[status] > 0)
+            {
+                os << ", " << replyStatusName(status) << " = " << snapshot.replyStatuses[status];
+            }
+        }
+
+        os << ", latency (us): " << LatencyHistogram::formatText(snapshot.buckets) << "\n";
+    }
+    return os.str();
+}
+
+string
+Server::MetricsRegistry::dumpJson() const
+{
+    ostringstream os;
+    os << "{\"operations\":[";
+    bool first = true;
+    for (const auto& snapshot : snapshot())
+    {
+        if (!first)
+        {
+            os << ",";
+        }
+        first = false;
+
+        os << "{\"identity\":\"" << escapeJson(Ice::identityToString(snapshot.id)) << "\",\"operation\":\""
+           << escapeJson(snapshot.operation) << "\",\"count\":" << snapshot.count << ",\"replyStatuses\":{";
+
+        bool firstStatus = true;
+        for (size_t status = 0; status < ReplyStatusCount; ++status)
+        {
+            if (snapshot.replyStatuses[status] > 0)
+            {
+                if (!firstStatus)
+                {
+                    os << ",";
+                }
+                firstStatus = false;
+                os << "\"" << replyStatusName(status) << "\":" << snapshot.replyStatuses[status];
+            }
+        }
+
+        os << "},\"latencyNs\":" << LatencyHistogram::formatJson(snapshot.buckets) << "}";
+    }
+    os << "]}";
+    return os.str();
+}
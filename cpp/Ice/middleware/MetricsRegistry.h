@@ -0,0 +1,155 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <Ice/Ice.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Server
+{
+    /// LatencyHistogram is a log-linear histogram in the style of HdrHistogram. Latencies below 16 ns have their own
+    /// bucket; above, each power of 2 is split into 16 buckets, which bounds the relative error to about 6%.
+    class LatencyHistogram final
+    {
+    public:
+        /// The number of bits used to split each power of 2.
+        static constexpr std::size_t SubBucketBits = 4;
+
+        /// The number of buckets per power of 2.
+        static constexpr std::size_t SubBucketCount = std::size_t{1} << SubBucketBits;
+
+        /// The number of buckets. Latencies of 2^40 ns (about 18 minutes) or more are recorded in the last bucket.
+        static constexpr std::size_t BucketCount = (40 - SubBucketBits + 1) * SubBucketCount;
+
+        /// Records a latency. Only the thread that owns this histogram can call record.
+        /// @param latency The latency to record.
+        void record(std::chrono::nanoseconds latency) noexcept;
+
+        /// Records a latency. Unlike record, recordConcurrent can be called by any number of threads concurrently.
+        /// @param latency The latency to record.
+        void recordConcurrent(std::chrono::nanoseconds latency) noexcept;
+
+        /// Adds the bucket counts of this histogram to buckets.
+        /// @param buckets The bucket counts to add to. Its size must be BucketCount.
+        void addTo(std::vector<std::uint64_t>& buckets) const noexcept;
+
+        /// Gets the index of the bucket that holds a value.
+        /// @param value The value, in nanoseconds.
+        /// @return The index of the bucket.
+        static std::size_t bucketIndex(std::uint64_t value) noexcept;
+
+        /// Gets the smallest value held by a bucket.
+        /// @param index The index of the bucket.
+        /// @return The smallest value held by this bucket, in nanoseconds.
+        static std::uint64_t bucketLowerBound(std::size_t index) noexcept;
+
+        /// Computes a percentile from bucket counts.
+        /// @param buckets The bucket counts, filled by addTo.
+        /// @param p The percentile, between 0 and 1.
+        /// @return The lower bound of the bucket that holds the percentile, in nanoseconds.
+        static std::uint64_t percentile(const std::vector<std::uint64_t>& buckets, double p) noexcept;
+
+        /// Formats the p50, p90 and p99 percentiles of bucket counts as text, in microseconds, together with the lower
+        /// bound of the highest non-empty bucket.
+        /// @param buckets The bucket counts, filled by addTo.
+        /// @return The formatted percentiles.
+        static std::string formatText(const std::vector<std::uint64_t>& buckets);
+
+        /// Formats the p50, p90 and p99 percentiles of bucket counts as a JSON object, in nanoseconds, together with
+        /// the lower bound of the highest non-empty bucket.
+        /// @param buckets The bucket counts, filled by addTo.
+        /// @return The formatted percentiles.
+        static std::string formatJson(const std::vector<std::uint64_t>& buckets);
+
+    private:
+        std::array<std::atomic<std::uint64_t>, BucketCount> _buckets{};
+    };
+
+    /// MetricsRegistry records the number of dispatches, their reply statuses and their latencies for each (identity,
+    /// operation) pair. Each dispatch thread records into its own shard without locking or atomic read-modify-write
+    /// operations; the shards are merged when the metrics are dumped.
+    class MetricsRegistry final
+    {
+    public:
+        /// The maximum number of (identity, operation) pairs tracked by the registry. Dispatches to other pairs are
+        /// recorded under identity `*` and operation `*`.
+        static constexpr std::size_t MaxOperations = 256;
+
+        /// The number of reply status counters per (identity, operation) pair. Reply statuses with a greater value
+        /// share the last counter.
+        static constexpr std::size_t ReplyStatusCount = 16;
+
+        /// Constructs an empty MetricsRegistry.
+        MetricsRegistry();
+
+        /// Destroys this MetricsRegistry.
+        ~MetricsRegistry();
+
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        /// Records a dispatch.
+        /// @param id The identity of the target object.
+        /// @param operation The name of the operation.
+        /// @param replyStatus The reply status of the dispatch.
+        /// @param latency The time it took to dispatch the request.
+        void record(
+            const Ice::Identity& id,
+            const std::string& operation,
+            Ice::ReplyStatus replyStatus,
+            std::chrono::nanoseconds latency);
+
+        /// Dumps the metrics as a human-readable text report.
+        /// @return The text report.
+        std::string dumpText() const;
+
+        /// Dumps the metrics as a JSON document.
+        /// @return The JSON document.
+        std::string dumpJson() const;
+
+    private:
+        struct OperationMetrics;
+        struct Shard;
+
+        // The merged metrics of an (identity, operation) pair.
+        struct Snapshot
+        {
+            Ice::Identity id;
+            std::string operation;
+            std::uint64_t count{0};
+            std::array<std::uint64_t, ReplyStatusCount> replyStatuses{};
+            std::vector<std::uint64_t> buckets;
+        };
+
+        Shard& localShard();
+        std::size_t operationIndex(Shard& shard, const Ice::Identity& id, const std::string& operation);
+        std::vector<Snapshot> snapshot() const;
+
+        // Identifies this registry in the thread-local shard maps. Unlike the address of the registry, this ID is never
+        // reused.
+        const std::uint64_t _id;
+
+        mutable std::mutex _mutex;
+
+        // The (identity, operation) pairs, indexed by operation index. An entry is immutable once assigned, and the
+        // shards only use the indexes they obtained while holding _mutex, so they can read their entries without
+        // locking.
+        std::unique_ptr<std::pair<Ice::Identity, std::string>[]> _operations;
+        std::size_t _operationCount{0};
+
+        // All the shards, one per dispatch thread. Protected by _mutex.
+        std::vector<std::unique_ptr<Shard>> _shards;
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "RateLimitMiddleware.h"
+
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+namespace
+{
+    // Gets the remote address of a connection, or an empty string for a collocated dispatch (no connection).
+    string getRemoteAddress(const Ice::ConnectionPtr& connection)
+    {
+        if (connection)
+        {
+            // The connection info of a secure connection wraps the connection info of the underlying transport.
+            for (Ice::ConnectionInfoPtr info = connection->getInfo(); info; info = info->underlying)
+            {
+                if (auto ipInfo = dynamic_pointer_cast<Ice::IPConnectionInfo>(info))
+                {
+                    return ipInfo->remoteAddress;
+                }
+            }
+        }
+        return "";
+    }
+}
+
+Server::RateLimitMiddleware::RateLimitMiddleware(Ice::ObjectPtr next, double requestsPerSecond, double burst)
+    : _next{std::move(next)},
+      _requestsPerSecond{requestsPerSecond},
+      _burst{max(burst, 1.0)}
+{
+}
+
+void
+Server::RateLimitMiddleware::dispatch(Ice::IncomingRequest& request, function<void(Ice::OutgoingResponse)> sendResponse)
+{
+    // Identify the client by its remote address.
+    string clientKey = getRemoteAddress(request.current().con);
+
+    if (!tryTake(clientKey))
+    {
+        throw Ice::DispatchException{
+            __FILE__,
+            __LINE__,
+            TooManyRequests,
+            "Rate limit exceeded for client '" + clientKey + "'"};
+    }
+
+    // Continue the dispatch pipeline.
+    _next->dispatch(request, std::move(sendResponse));
+}
+
+bool
+Server::RateLimitMiddleware::tryTake(const string& clientKey)
+{
+    Shard& shard = _shards[hash<string>{}(clientKey) % ShardCount];
+    auto now = chrono::steady_clock::now();
+
+    const lock_guard<mutex> lock(shard.mutex);
+    auto p = shard.index.find(clientKey);
+    if (p == shard.index.end())
+    {
+        if (shard.index.size() >= MaxBucketsPerShard)
+        {
+            // Evict the least recently used bucket.
+            shard.index.erase(shard.buckets.back().first);
+            shard.buckets.pop_back();
+        }
+
+        // A new client starts with a full bucket.
+        shard.buckets.emplace_front(clientKey, Bucket{_burst, now});
+        p = shard.index.emplace(shard.buckets.front().first, shard.buckets.begin()).first;
+    }
+    else
+    {
+        // Move the bucket to the front of the list, without copying it.
+        shard.buckets.splice(shard.buckets.begin(), shard.buckets, p->second);
+    }
+
+    // Refill the bucket for the time elapsed since the last refill, up to the burst size.
+    Bucket& bucket = p->second->second;
+    chrono::duration<double> elapsed = now - bucket.lastRefill;
+    bucket.tokens = min(_burst, bucket.tokens + elapsed.count() * _requestsPerSecond);
+    bucket.lastRefill = now;
+
+    if (bucket.tokens < 1.0)
+    {
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    return true;
+}
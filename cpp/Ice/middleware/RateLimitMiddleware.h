@@ -0,0 +1,77 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef RATE_LIMIT_MIDDLEWARE_H
+#define RATE_LIMIT_MIDDLEWARE_H
+
+#include <Ice/Ice.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace Server
+{
+    /// The reply status of the dispatch exception sent back to a client that exceeds its rate limit. This is a custom
+    /// reply status: its value is not used by Ice.
+    constexpr Ice::ReplyStatus TooManyRequests{static_cast<Ice::ReplyStatus>(100)};
+
+    /// The RateLimitMiddleware limits the rate of requests of each client with a token bucket. A client is identified
+    /// by the remote address of its connection: unlike a request context entry, the client can't pick this address, so
+    /// the RateLimitMiddleware can run before the Authorization middleware.
+    class RateLimitMiddleware final : public Ice::Object
+    {
+    public:
+        /// Constructs a RateLimitMiddleware.
+        /// @param next The next Ice::Object in the dispatch pipeline.
+        /// @param requestsPerSecond The sustained number of requests per second allowed for each client.
+        /// @param burst The maximum number of requests a client can send in a burst, after being idle.
+        RateLimitMiddleware(Ice::ObjectPtr next, double requestsPerSecond, double burst);
+
+        // Reimplements the dispatch function provided by Ice::Object.
+        void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
+
+    private:
+        struct Bucket
+        {
+            double tokens;
+            std::chrono::steady_clock::time_point lastRefill;
+        };
+
+        using BucketList = std::list<std::pair<std::string, Bucket>>;
+
+        // The buckets are split into shards, each with its own mutex, so that dispatch threads serving different
+        // clients rarely contend.
+        struct Shard
+        {
+            std::mutex mutex;
+
+            // The buckets, from the most recently used to the least recently used.
+            BucketList buckets;
+
+            // The buckets by client key. The keys are views of the strings held by the buckets list.
+            std::unordered_map<std::string_view, BucketList::iterator> index;
+        };
+
+        static constexpr std::size_t ShardCount = 16;
+
+        // The maximum number of buckets per shard. Beyond this number, the shard evicts its least recently used
+        // bucket.
+        static constexpr std::size_t MaxBucketsPerShard = 4096;
+
+        // Takes a token from the bucket of the given client. Returns false if the bucket is empty.
+        bool tryTake(const std::string& clientKey);
+
+        const Ice::ObjectPtr _next;
+        const double _requestsPerSecond;
+        const double _burst;
+        std::array<Shard, ShardCount> _shards;
+    };
+}
+
+#endif
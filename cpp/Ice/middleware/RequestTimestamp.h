@@ -0,0 +1,54 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef REQUEST_TIMESTAMP_H
+#define REQUEST_TIMESTAMP_H
+
+#include <Ice/Ice.h>
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// Request timestamps record when a client sent a request, in the request context. A server can then measure how long
+/// the request waited before its dispatch started. The timestamps come from the client's clock: they are only
+/// meaningful when the client and server clocks are synchronized, for example when they run on the same host.
+namespace RequestTimestamp
+{
+    /// The key of the request context entry that carries the timestamp.
+    constexpr std::string_view Key = "sentAt";
+
+    /// Adds the current time to a request context.
+    /// @param context The request context.
+    inline void stamp(Ice::Context& context)
+    {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        context[std::string{Key}] = std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+
+    /// Reads the timestamp of a request.
+    /// @param context The request context.
+    /// @return The time the request was sent, or nullopt if the request context doesn't carry a valid timestamp.
+    inline std::optional<std::chrono::system_clock::time_point> read(const Ice::Context& context)
+    {
+        auto p = context.find(std::string{Key});
+        if (p == context.end())
+        {
+            return std::nullopt;
+        }
+
+        std::int64_t nanoseconds = 0;
+        const std::string& value = p->second;
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), nanoseconds);
+        if (error != std::errc{} || end != value.data() + value.size())
+        {
+            return std::nullopt;
+        }
+        return std::chrono::system_clock::time_point{
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{nanoseconds})};
+    }
+}
+
+#endif
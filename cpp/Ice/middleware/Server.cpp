@@ -1,7 +1,14 @@
 // Copyright (c) ZeroC, Inc.
 
+#include "AsyncLogger.h"
 #include "AuthorizationMiddleware.h"
 #include "Chatbot.h"
+#include "DispatchTimingMiddleware.h"
+#include "MetricsAdmin.h"
+#include "MetricsMiddleware.h"
+#include "RateLimitMiddleware.h"
+#include "TokenValidator.h"
+#include "TracingMiddleware.h"
 
 #include <Ice/Ice.h>
 #include <iostream>
@@ -24,13 +31,46 @@ main(int argc, char* argv[])
     // Create an object adapter that listens for incoming requests and dispatches them to servants.
     auto adapter = communicator->createObjectAdapterWithEndpoints("GreeterAdapter", "tcp -p 4061");
 
-    // Install the Authorization middleware in the object adapter.
+    // Install the DispatchTiming middleware in the object adapter. It's installed first, so that it sees requests as
+    // early as possible. Its queue wait and service time histograms tell us whether slow requests wait for a thread
+    // from the server thread pool (Ice.ThreadPool.Server.SizeMax is too small) or are slow to dispatch.
+    auto dispatchTimings = make_shared<Server::DispatchTimings>();
+    adapter->use(
+        [adapterTimings = dispatchTimings->getAdapterTimings(adapter->getName())](Ice::ObjectPtr next)
+        { return make_shared<Server::DispatchTimingMiddleware>(std::move(next), adapterTimings); });
+
+    // Install the Tracing middleware in the object adapter. It records the dispatches of sampled traces to spans.jsonl,
+    // and samples 10% of the requests that don't carry a trace context.
+    auto spanExporter = make_shared<Server::SpanExporter>("spans.jsonl", 8192);
+    adapter->use([spanExporter](Ice::ObjectPtr next)
+                 { return make_shared<Server::TracingMiddleware>(std::move(next), spanExporter, 0.1); });
+
+    // Install the Metrics middleware in the object adapter. It's installed before the RateLimit and Authorization
+    // middleware, so it sees the requests they reject.
+    auto metricsRegistry = make_shared<Server::MetricsRegistry>();
+    adapter->use([metricsRegistry](Ice::ObjectPtr next)
+                 { return make_shared<Server::MetricsMiddleware>(std::move(next), metricsRegistry); });
+
+    // Install the RateLimit middleware in the object adapter. Each client can send 5 requests per second, with bursts
+    // of up to 10 requests. A client is identified by its IP address, which it can't choose freely like a request
+    // context entry. This middleware is installed before the Authorization middleware, so that a client that floods
+    // the server with requests doesn't cost us token validations.
     adapter->use([](Ice::ObjectPtr next)
-                 { return make_shared<Server::AuthorizationMiddleware>(std::move(next), "iced tea"); });
+                 { return make_shared<Server::RateLimitMiddleware>(std::move(next), 5.0, 10.0); });
+
+    // Install the Authorization middleware in the object adapter. It accepts tokens signed with our secret, which we
+    // hardcode in this demo for simplicity, and logs at most 100 messages per second.
+    auto validator = make_shared<Server::HmacTokenValidator>("iced tea");
+    auto logger = make_shared<Server::AsyncLogger>(100);
+    adapter->use([validator, logger](Ice::ObjectPtr next)
+                 { return make_shared<Server::AuthorizationMiddleware>(std::move(next), validator, logger); });
 
     // Register the Chatbot servant with the adapter.
     adapter->add(make_shared<Server::Chatbot>(), Ice::Identity{"greeter"});
 
+    // Register the MetricsAdmin servant with the adapter. Like the greeter, it's only reachable with a valid token.
+    adapter->add(make_shared<Server::MetricsAdmin>(metricsRegistry, dispatchTimings), Ice::Identity{"metrics"});
+
     // Start dispatching requests.
     adapter->activate();
     cout << "Listening on port 4061..." << endl;
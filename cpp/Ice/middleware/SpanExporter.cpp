@@ -0,0 +1,171 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "SpanExporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    size_t roundUpToPowerOf2(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // Writes a string to a JSON document, with the escape sequences JSON requires.
+    void writeJsonString(ostream& os, const char* value)
+    {
+        os << '"';
+        for (; *value; ++value)
+        {
+            char c = *value;
+            if (c == '"' || c == '\\')
+            {
+                os << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                os << "\\u" << setw(4) << static_cast<int>(c);
+            }
+            else
+            {
+                os << c;
+            }
+        }
+        os << '"';
+    }
+}
+
+void
+Server::Span::copy(array<char, 32>& field, string_view value) noexcept
+{
+    size_t length = min(value.size(), field.size() - 1);
+    value.copy(field.data(), length);
+    field[length] = '\0';
+}
+
+Server::SpanExporter::SpanExporter(const string& path, size_t capacity)
+    : _mask{roundUpToPowerOf2(max<size_t>(capacity, 2)) - 1},
+      _slots{new Slot[_mask + 1]},
+      _file{path, ios::app}
+{
+    if (!_file)
+    {
+        throw runtime_error("cannot open span file '" + path + "'");
+    }
+
+    for (size_t i = 0; i <= _mask; ++i)
+    {
+        _slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    _thread = thread{[this] { run(); }};
+}
+
+Server::SpanExporter::~SpanExporter()
+{
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+bool
+Server::SpanExporter::tryPush(const Span& span) noexcept
+{
+    size_t position = _pushPosition.load(memory_order_relaxed);
+    while (true)
+    {
+        Slot& slot = _slots[position & _mask];
+        size_t sequence = slot.sequence.load(memory_order_acquire);
+        auto difference = static_cast<ptrdiff_t>(sequence - position);
+        if (difference == 0)
+        {
+            // The slot is free: claim it.
+            if (_pushPosition.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+            {
+                slot.span = span;
+                slot.sequence.store(position + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The slot still holds a span that the background thread hasn't exported yet: the ring buffer is full.
+            _dropped.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            // Another producer claimed this slot.
+            position = _pushPosition.load(memory_order_relaxed);
+        }
+    }
+}
+
+bool
+Server::SpanExporter::tryPop(Span& span) noexcept
+{
+    Slot& slot = _slots[_popPosition & _mask];
+    if (slot.sequence.load(memory_order_acquire) != _popPosition + 1)
+    {
+        return false;
+    }
+    span = slot.span;
+
+    // Release the slot for the producers of the next lap.
+    slot.sequence.store(_popPosition + _mask + 1, memory_order_release);
+    ++_popPosition;
+    return true;
+}
+
+void
+Server::SpanExporter::run()
+{
+    // IDs and control characters are written in hex, with leading zeros.
+    _file << hex << setfill('0');
+
+    bool stopped = false;
+    while (!stopped)
+    {
+        {
+            // Export a batch every 100 ms; the producers never signal this thread.
+            unique_lock<mutex> lock(_mutex);
+            _condition.wait_for(lock, 100ms, [this] { return _stopped; });
+            stopped = _stopped;
+        }
+
+        Span span;
+        while (tryPop(span))
+        {
+            _file << "{\"traceId\":\"" << setw(16) << span.traceIdHigh << setw(16) << span.traceIdLow
+                  << "\",\"spanId\":\"" << setw(16) << span.spanId << "\",\"parentSpanId\":\"" << setw(16)
+                  << span.parentSpanId << "\",\"identity\":";
+            writeJsonString(_file, span.identity.data());
+            _file << ",\"operation\":";
+            writeJsonString(_file, span.operation.data());
+            _file << "," << dec << "\"startTime\":" << span.startTime
+                  << ",\"duration\":" << span.duration << ",\"replyStatus\":" << static_cast<int>(span.replyStatus)
+                  << "}\n"
+                  << hex;
+        }
+
+        uint64_t dropped = _dropped.exchange(0, memory_order_relaxed);
+        if (dropped > 0)
+        {
+            _file << dec << "{\"droppedSpans\":" << dropped << "}\n" << hex;
+        }
+        _file.flush();
+    }
+}
@@ -0,0 +1,89 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef SPAN_EXPORTER_H
+#define SPAN_EXPORTER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace Server
+{
+    /// A Span records one dispatch of a sampled trace. It has a fixed size and holds no pointers, so recording a span
+    /// doesn't allocate.
+    struct Span
+    {
+        std::uint64_t traceIdHigh;
+        std::uint64_t traceIdLow;
+        std::uint64_t spanId;
+        std::uint64_t parentSpanId; // 0 for a root span.
+        std::int64_t startTime;     // In nanoseconds since the Unix epoch.
+        std::int64_t duration;      // In nanoseconds.
+        std::uint8_t replyStatus;
+        std::array<char, 32> identity; // Null-terminated; truncated if longer.
+        std::array<char, 32> operation; // Null-terminated; truncated if longer.
+
+        /// Copies a string into one of the fixed-size fields of a span.
+        /// @param field The field.
+        /// @param value The string to copy.
+        static void copy(std::array<char, 32>& field, std::string_view value) noexcept;
+    };
+
+    /// SpanExporter collects spans in a lock-free ring buffer and appends them in batches to a file, in JSON lines
+    /// format, from a background thread. When the ring buffer is full, new spans are dropped.
+    class SpanExporter final
+    {
+    public:
+        /// Constructs a SpanExporter and starts its background thread.
+        /// @param path The path of the file the spans are appended to.
+        /// @param capacity The capacity of the ring buffer. It's rounded up to a power of 2.
+        SpanExporter(const std::string& path, std::size_t capacity);
+
+        /// Exports the remaining spans and stops the background thread.
+        ~SpanExporter();
+
+        SpanExporter(const SpanExporter&) = delete;
+        SpanExporter& operator=(const SpanExporter&) = delete;
+
+        /// Adds a span to the ring buffer. Can be called concurrently by any number of threads.
+        /// @param span The span.
+        /// @return true if the span was added, false if the ring buffer is full and the span was dropped.
+        bool tryPush(const Span& span) noexcept;
+
+    private:
+        // A slot of the ring buffer. The sequence number tells whether the slot is ready for a producer or for the
+        // consumer, as in Dmitry Vyukov's bounded MPMC queue.
+        struct Slot
+        {
+            std::atomic<std::size_t> sequence;
+            Span span;
+        };
+
+        // Removes a span from the ring buffer. Only the background thread calls tryPop.
+        bool tryPop(Span& span) noexcept;
+
+        void run();
+
+        const std::size_t _mask;
+        std::unique_ptr<Slot[]> _slots;
+        std::atomic<std::size_t> _pushPosition{0};
+        std::size_t _popPosition{0};
+        std::atomic<std::uint64_t> _dropped{0};
+
+        std::ofstream _file;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _stopped{false};
+        std::thread _thread;
+    };
+}
+
+#endif
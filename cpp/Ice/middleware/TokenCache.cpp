@@ -0,0 +1,55 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "TokenCache.h"
+
+#include <functional>
+
+using namespace std;
+
+Server::TokenCache::TokenCache(size_t maxTokensPerShard) : _maxTokensPerShard{maxTokensPerShard} {}
+
+bool
+Server::TokenCache::contains(string_view token, chrono::system_clock::time_point now)
+{
+    size_t hash = std::hash<string_view>{}(token);
+    Shard& s = shard(hash);
+
+    const lock_guard<mutex> lock(s.mutex);
+    auto p = s.entries.find(hash);
+    if (p == s.entries.end() || p->second.token != token)
+    {
+        return false;
+    }
+    if (p->second.expiration <= now)
+    {
+        s.entries.erase(p);
+        return false;
+    }
+    return true;
+}
+
+void
+Server::TokenCache::add(string_view token, chrono::system_clock::time_point expiration)
+{
+    size_t hash = std::hash<string_view>{}(token);
+    Shard& s = shard(hash);
+
+    const lock_guard<mutex> lock(s.mutex);
+    if (s.entries.size() >= _maxTokensPerShard)
+    {
+        // The shard is full: evict the expired tokens, and if that's not enough, start over with an empty shard. The
+        // evicted tokens are simply validated again on their next use.
+        auto now = chrono::system_clock::now();
+        for (auto p = s.entries.begin(); p != s.entries.end();)
+        {
+            p = p->second.expiration <= now ? s.entries.erase(p) : next(p);
+        }
+        if (s.entries.size() >= _maxTokensPerShard)
+        {
+            s.entries.clear();
+        }
+    }
+
+    // If another token has the same hash, the new token replaces it.
+    s.entries[hash] = Entry{string{token}, expiration};
+}
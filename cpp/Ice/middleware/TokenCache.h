@@ -0,0 +1,60 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef TOKEN_CACHE_H
+#define TOKEN_CACHE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Server
+{
+    /// TokenCache remembers the tokens that were successfully validated, until they expire. The cache is split into
+    /// shards, each with its own mutex, so that dispatch threads checking different tokens rarely contend.
+    class TokenCache final
+    {
+    public:
+        /// The number of shards.
+        static constexpr std::size_t ShardCount = 16;
+
+        /// Constructs a TokenCache.
+        /// @param maxTokensPerShard The maximum number of tokens cached by each shard.
+        explicit TokenCache(std::size_t maxTokensPerShard);
+
+        /// Checks if a token is in the cache and has not expired.
+        /// @param token The token to look up.
+        /// @param now The current time.
+        /// @return true if the token was validated before and has not expired, false otherwise.
+        bool contains(std::string_view token, std::chrono::system_clock::time_point now);
+
+        /// Adds a validated token to the cache.
+        /// @param token The token.
+        /// @param expiration The expiration time of the token.
+        void add(std::string_view token, std::chrono::system_clock::time_point expiration);
+
+    private:
+        struct Entry
+        {
+            std::string token;
+            std::chrono::system_clock::time_point expiration;
+        };
+
+        // The entries are keyed by the hash of their token, so that lookups don't need to create a std::string.
+        struct Shard
+        {
+            std::mutex mutex;
+            std::unordered_map<std::size_t, Entry> entries;
+        };
+
+        Shard& shard(std::size_t hash) { return _shards[hash % ShardCount]; }
+
+        const std::size_t _maxTokensPerShard;
+        std::array<Shard, ShardCount> _shards;
+    };
+}
+
+#endif
@@ -0,0 +1,19 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "TokenValidator.h"
+#include "HmacToken.h"
+
+using namespace std;
+
+Server::HmacTokenValidator::HmacTokenValidator(string secret) : _secret{std::move(secret)} {}
+
+optional<chrono::system_clock::time_point>
+Server::HmacTokenValidator::validate(string_view token) const
+{
+    optional<chrono::system_clock::time_point> expiration = HmacToken::verify(_secret, token);
+    if (expiration && *expiration > chrono::system_clock::now())
+    {
+        return expiration;
+    }
+    return nullopt;
+}
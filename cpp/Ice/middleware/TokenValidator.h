@@ -0,0 +1,42 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef TOKEN_VALIDATOR_H
+#define TOKEN_VALIDATOR_H
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Server
+{
+    /// A TokenValidator checks the tokens carried by incoming requests.
+    class TokenValidator
+    {
+    public:
+        virtual ~TokenValidator() = default;
+
+        /// Validates a token.
+        /// @param token The token to validate.
+        /// @return The expiration time of the token if it's valid, nullopt otherwise. The caller can cache this result
+        /// until the token expires.
+        virtual std::optional<std::chrono::system_clock::time_point> validate(std::string_view token) const = 0;
+    };
+
+    /// HmacTokenValidator accepts tokens created by HmacToken::create with its secret that have not expired yet.
+    class HmacTokenValidator final : public TokenValidator
+    {
+    public:
+        /// Constructs an HmacTokenValidator.
+        /// @param secret The secret used to sign the tokens.
+        explicit HmacTokenValidator(std::string secret);
+
+        // Implements the pure virtual function in the base class (TokenValidator).
+        std::optional<std::chrono::system_clock::time_point> validate(std::string_view token) const final;
+
+    private:
+        const std::string _secret;
+    };
+}
+
+#endif
@@ -0,0 +1,94 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "TraceContext.h"
+
+#include <charconv>
+#include <random>
+
+using namespace std;
+
+namespace
+{
+    // Generates a random, non-zero 64-bit ID.
+    uint64_t generateId()
+    {
+        thread_local mt19937_64 generator{random_device{}()};
+        uint64_t id;
+        do
+        {
+            id = generator();
+        } while (id == 0);
+        return id;
+    }
+
+    // Parses a fixed-length hex number.
+    bool parseHex(string_view value, uint64_t& result)
+    {
+        auto [end, error] = from_chars(value.data(), value.data() + value.size(), result, 16);
+        return error == errc{} && end == value.data() + value.size();
+    }
+
+    // Appends value to s as a hex number of the given width, with leading zeros.
+    void appendHex(string& s, uint64_t value, int width)
+    {
+        const char* hexDigits = "0123456789abcdef";
+        for (int shift = (width - 1) * 4; shift >= 0; shift -= 4)
+        {
+            s.push_back(hexDigits[(value >> shift) & 0x0f]);
+        }
+    }
+}
+
+Tracing::TraceContext
+Tracing::TraceContext::createRoot(bool sampled)
+{
+    return {generateId(), generateId(), generateId(), sampled};
+}
+
+optional<Tracing::TraceContext>
+Tracing::TraceContext::parse(string_view traceParent)
+{
+    // version-traceId-spanId-flags
+    if (traceParent.size() != 55 || traceParent.substr(0, 3) != "00-" || traceParent[35] != '-' ||
+        traceParent[52] != '-')
+    {
+        return nullopt;
+    }
+
+    TraceContext context;
+    uint64_t flags = 0;
+    if (!parseHex(traceParent.substr(3, 16), context.traceIdHigh) ||
+        !parseHex(traceParent.substr(19, 16), context.traceIdLow) ||
+        !parseHex(traceParent.substr(36, 16), context.spanId) || !parseHex(traceParent.substr(53, 2), flags))
+    {
+        return nullopt;
+    }
+    context.sampled = (flags & 0x01) != 0;
+    return context;
+}
+
+Tracing::TraceContext
+Tracing::TraceContext::createChild() const
+{
+    return {traceIdHigh, traceIdLow, generateId(), sampled};
+}
+
+string
+Tracing::TraceContext::toString() const
+{
+    string s;
+    s.reserve(55);
+    s += "00-";
+    appendHex(s, traceIdHigh, 16);
+    appendHex(s, traceIdLow, 16);
+    s += '-';
+    appendHex(s, spanId, 16);
+    s += sampled ? "-01" : "-00";
+    return s;
+}
+
+void
+Tracing::TraceContext::inject(Ice::Context& context) const
+{
+    context[string{TraceParentKey}] = toString();
+}
@@ -0,0 +1,59 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef TRACE_CONTEXT_H
+#define TRACE_CONTEXT_H
+
+#include <Ice/Ice.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Tracing
+{
+    /// The key of the request context entry that carries the trace context.
+    constexpr std::string_view TraceParentKey = "traceparent";
+
+    /// TraceContext identifies a span within a trace. It's carried in request contexts using the format of the W3C
+    /// traceparent header: `00-<32 hex digits trace ID>-<16 hex digits span ID>-<2 hex digits flags>`.
+    struct TraceContext
+    {
+        /// The high-order 64 bits of the trace ID.
+        std::uint64_t traceIdHigh{0};
+
+        /// The low-order 64 bits of the trace ID.
+        std::uint64_t traceIdLow{0};
+
+        /// The ID of the span.
+        std::uint64_t spanId{0};
+
+        /// Whether this trace is sampled (recorded). The decision is made once, when the trace starts, and all the
+        /// spans of the trace follow it.
+        bool sampled{false};
+
+        /// Creates the trace context of a new trace.
+        /// @param sampled Whether the new trace is sampled.
+        /// @return The trace context of the root span of the new trace.
+        static TraceContext createRoot(bool sampled);
+
+        /// Parses a trace context.
+        /// @param traceParent The trace context in traceparent format.
+        /// @return The trace context, or nullopt if traceParent is not a valid trace context.
+        static std::optional<TraceContext> parse(std::string_view traceParent);
+
+        /// Creates the trace context of a child span, in the same trace.
+        /// @return The trace context of the child span.
+        TraceContext createChild() const;
+
+        /// Formats this trace context in traceparent format.
+        /// @return The formatted trace context.
+        std::string toString() const;
+
+        /// Adds this trace context to a request context.
+        /// @param context The request context.
+        void inject(Ice::Context& context) const;
+    };
+}
+
+#endif
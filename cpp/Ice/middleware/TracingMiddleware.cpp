@@ -0,0 +1,102 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "TracingMiddleware.h"
+#include "TraceContext.h"
+
+#include <chrono>
+#include <random>
+
+using namespace std;
+
+namespace
+{
+    bool sample(double sampleRate)
+    {
+        thread_local minstd_rand generator{random_device{}()};
+        return uniform_real_distribution<double>{0.0, 1.0}(generator) < sampleRate;
+    }
+
+    int64_t nanosecondsSinceEpoch(chrono::system_clock::time_point timePoint)
+    {
+        return chrono::duration_cast<chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+    }
+}
+
+Server::TracingMiddleware::TracingMiddleware(Ice::ObjectPtr next, shared_ptr<SpanExporter> exporter, double sampleRate)
+    : _next{std::move(next)},
+      _exporter{std::move(exporter)},
+      _sampleRate{sampleRate}
+{
+}
+
+void
+Server::TracingMiddleware::dispatch(Ice::IncomingRequest& request, function<void(Ice::OutgoingResponse)> sendResponse)
+{
+    // The key of the trace context entry, allocated once.
+    static const string traceParentKey{Tracing::TraceParentKey};
+
+    Ice::Current& current = request.current();
+
+    // Continue the trace of the caller, or start a new trace. The sampling decision is made once per trace, by the
+    // first process in the trace (head-based sampling). We don't generate IDs for traces that are not sampled.
+    optional<Tracing::TraceContext> parent;
+    auto p = current.ctx.find(traceParentKey);
+    if (p != current.ctx.end())
+    {
+        parent = Tracing::TraceContext::parse(p->second);
+    }
+
+    if (parent ? !parent->sampled : !sample(_sampleRate))
+    {
+        _next->dispatch(request, std::move(sendResponse));
+        return;
+    }
+    Tracing::TraceContext trace = parent ? parent->createChild() : Tracing::TraceContext::createRoot(true);
+
+    // Replace the trace context seen by the servant with the context of our span, so that the requests the servant
+    // sends with this request context continue the trace as children of our span.
+    trace.inject(current.ctx);
+
+    Span span{};
+    span.traceIdHigh = trace.traceIdHigh;
+    span.traceIdLow = trace.traceIdLow;
+    span.spanId = trace.spanId;
+    span.parentSpanId = parent ? parent->spanId : 0;
+    span.startTime = nanosecondsSinceEpoch(chrono::system_clock::now());
+    Span::copy(span.identity, current.id.name);
+    Span::copy(span.operation, current.operation);
+
+    auto start = chrono::steady_clock::now();
+    auto record = [exporter = _exporter, start](Span& span, Ice::ReplyStatus replyStatus)
+    {
+        span.duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        span.replyStatus = static_cast<uint8_t>(replyStatus);
+        exporter->tryPush(span);
+    };
+
+    try
+    {
+        _next->dispatch(
+            request,
+            [sendResponse = std::move(sendResponse), record, span](Ice::OutgoingResponse response) mutable
+            {
+                record(span, response.replyStatus());
+                sendResponse(std::move(response));
+            });
+    }
+    catch (const Ice::DispatchException& exception)
+    {
+        record(span, exception.replyStatus());
+        throw;
+    }
+    catch (const Ice::UserException&)
+    {
+        record(span, Ice::ReplyStatus::UserException);
+        throw;
+    }
+    catch (...)
+    {
+        record(span, Ice::ReplyStatus::UnknownException);
+        throw;
+    }
+}
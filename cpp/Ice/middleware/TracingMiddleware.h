@@ -0,0 +1,36 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef TRACING_MIDDLEWARE_H
+#define TRACING_MIDDLEWARE_H
+
+#include "SpanExporter.h"
+
+#include <Ice/Ice.h>
+
+namespace Server
+{
+    /// The TracingMiddleware records a span for each dispatch of a sampled trace. It reads the trace context from the
+    /// request context; when a request doesn't carry a trace context, the middleware starts a new trace and samples it
+    /// with the given probability. For a sampled trace, the middleware replaces the trace context of the request with
+    /// the context of its span before dispatching the request to the servant. Dispatches of traces that are not
+    /// sampled only cost a context lookup, and a random number when the request doesn't carry a trace context.
+    class TracingMiddleware final : public Ice::Object
+    {
+    public:
+        /// Constructs a TracingMiddleware.
+        /// @param next The next Ice::Object in the dispatch pipeline.
+        /// @param exporter The exporter for the recorded spans.
+        /// @param sampleRate The probability of sampling a new trace, between 0 and 1.
+        TracingMiddleware(Ice::ObjectPtr next, std::shared_ptr<SpanExporter> exporter, double sampleRate);
+
+        // Reimplements the dispatch function provided by Ice::Object.
+        void dispatch(Ice::IncomingRequest& request, std::function<void(Ice::OutgoingResponse)> sendResponse) final;
+
+    private:
+        const Ice::ObjectPtr _next;
+        const std::shared_ptr<SpanExporter> _exporter;
+        const double _sampleRate;
+    };
+}
+
+#endif
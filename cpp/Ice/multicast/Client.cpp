@@ -11,36 +11,78 @@
 using namespace std;
 using namespace Demo;
 
+//
+// DiscoverReplyI caches the Hello object found by the last lookup for the time-to-live (TTL) of the cache, so that
+// repeated lookups are answered locally, without any network traffic. Concurrent lookups share a single multicast
+// lookup, and the first reply completes this lookup: the replies of the other servers are ignored.
+//
 class DiscoverReplyI final : public DiscoverReply
 {
 public:
+    explicit DiscoverReplyI(chrono::seconds ttl) : _ttl(ttl) {}
+
     void reply(optional<Ice::ObjectPrx> obj, const Ice::Current&) final
     {
         {
             const lock_guard<mutex> lock(_mutex);
-            if (!_obj)
+            if (!_lookupPending || !obj)
             {
-                _obj = obj;
+                return;
             }
+            _obj = obj;
+            _expiration = chrono::steady_clock::now() + _ttl;
+            _lookupPending = false;
         }
         _cond.notify_all();
     }
 
-    optional<Ice::ObjectPrx> waitReply(int seconds)
+    optional<Ice::ObjectPrx> find(const DiscoverPrx& discover, const DiscoverReplyPrx& reply, chrono::seconds timeout)
     {
-        auto until = chrono::system_clock::now() + chrono::seconds(seconds);
         unique_lock<mutex> lock(_mutex);
-        bool timedOut = false;
-        do
+        if (_obj && chrono::steady_clock::now() < _expiration)
         {
-            timedOut = _cond.wait_until(lock, until) == cv_status::timeout;
-        } while (!_obj && !timedOut);
+            ++_cacheHits;
+            return _obj;
+        }
 
+        _obj = nullopt;
+        if (!_lookupPending)
+        {
+            _lookupPending = true;
+            ++_lookups;
+            lock.unlock();
+            discover->lookup(reply);
+            lock.lock();
+        }
+
+        if (!_cond.wait_for(lock, timeout, [this] { return !_lookupPending; }))
+        {
+            // No reply: the next call sends a new lookup.
+            _lookupPending = false;
+        }
         return _obj;
     }
 
+    // Removes the cached object, for example after an invocation on this object failed.
+    void invalidate()
+    {
+        const lock_guard<mutex> lock(_mutex);
+        _obj = nullopt;
+    }
+
+    void printStatistics()
+    {
+        const lock_guard<mutex> lock(_mutex);
+        cout << "sent " << _lookups << " lookup(s), answered " << _cacheHits << " lookup(s) from the cache" << endl;
+    }
+
 private:
+    const chrono::seconds _ttl;
     optional<Ice::ObjectPrx> _obj;
+    chrono::steady_clock::time_point _expiration;
+    bool _lookupPending = false;
+    int _lookups = 0;
+    int _cacheHits = 0;
     mutex _mutex;
     condition_variable _cond;
 };
@@ -94,26 +136,54 @@ int
 run(const shared_ptr<Ice::Communicator>& communicator, const string& appName)
 {
     auto adapter = communicator->createObjectAdapter("DiscoverReply");
-    auto replyI = make_shared<DiscoverReplyI>();
+    auto replyI = make_shared<DiscoverReplyI>(
+        chrono::seconds(communicator->getProperties()->getPropertyAsIntWithDefault("Discover.CacheTTL", 30)));
     auto reply = Ice::uncheckedCast<DiscoverReplyPrx>(adapter->addWithUUID(replyI));
     adapter->activate();
 
     auto discover = Ice::uncheckedCast<DiscoverPrx>(communicator->propertyToProxy("Discover.Proxy")->ice_datagram());
-    discover->lookup(reply);
-    auto base = replyI->waitReply(2);
-    if (!base)
-    {
-        cerr << appName << ": no replies" << endl;
-        return 1;
-    }
-    auto hello = Ice::checkedCast<HelloPrx>(base);
-    if (!hello)
+
+    //
+    // Look up the Hello object before each call to sayHello. Only the first lookup goes to the network; the next ones
+    // are answered by the cache.
+    //
+    for (int i = 0; i < 3; ++i)
     {
-        cerr << appName << ": invalid reply" << endl;
-        return 1;
-    }
+        for (int attempt = 1;; ++attempt)
+        {
+            auto base = replyI->find(discover, reply, chrono::seconds(2));
+            if (!base)
+            {
+                cerr << appName << ": no replies" << endl;
+                return 1;
+            }
 
-    hello->sayHello();
+            try
+            {
+                auto hello = Ice::checkedCast<HelloPrx>(base);
+                if (!hello)
+                {
+                    cerr << appName << ": invalid reply" << endl;
+                    return 1;
+                }
+                hello->sayHello();
+                break;
+            }
+            catch (const Ice::LocalException& ex)
+            {
+                //
+                // The server that replied may be gone: invalidate the cache, and retry once with a new lookup.
+                //
+                replyI->invalidate();
+                if (attempt == 2)
+                {
+                    throw;
+                }
+                cerr << appName << ": " << ex.what() << ", retrying with a new lookup" << endl;
+            }
+        }
+    }
 
+    replyI->printStatistics();
     return 0;
 }
@@ -3,7 +3,14 @@
 #include "Discovery.h"
 #include "Hello.h"
 #include <Ice/Ice.h>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
 
 using namespace std;
 using namespace Demo;
@@ -14,28 +21,105 @@ public:
     void sayHello(const Ice::Current&) final { cout << "Hello World!" << endl; }
 };
 
+//
+// DiscoverI replies to each lookup after a random delay, so that the replies of many servers to many clients are
+// spread over the jitter window instead of arriving in a single burst. A lookup from a client whose reply is still
+// waiting for its due time shares this reply; once the reply is sent, the next lookup from this client gets a new one.
+//
 class DiscoverI final : public Discover
 {
 public:
-    DiscoverI(const optional<Ice::ObjectPrx>& obj) : _obj(obj) {}
+    DiscoverI(const optional<Ice::ObjectPrx>& obj, chrono::milliseconds maxJitter)
+        : _obj(obj),
+          _jitter(0, maxJitter.count()),
+          _thread([this] { run(); })
+    {
+    }
+
+    ~DiscoverI() final
+    {
+        {
+            const lock_guard<mutex> lock(_mutex);
+            _destroyed = true;
+        }
+        _cond.notify_one();
+        _thread.join();
+    }
 
     void lookup(optional<DiscoverReplyPrx> reply, const Ice::Current&) final
     {
-        try
+        if (!reply)
+        {
+            return;
+        }
+
         {
-            if (reply)
+            const lock_guard<mutex> lock(_mutex);
+
+            // Each client receives replies with its own DiscoverReply object, so the identity of this object
+            // identifies the client.
+            if (!_pendingClients.insert(reply->ice_getIdentity()).second)
             {
-                reply->reply(_obj);
+                return; // the reply to an earlier lookup from this client is still pending
             }
+            _pending.emplace(chrono::steady_clock::now() + chrono::milliseconds(_jitter(_random)), std::move(*reply));
         }
-        catch (const Ice::LocalException&)
+        _cond.notify_one();
+    }
+
+private:
+    void run()
+    {
+        unique_lock<mutex> lock(_mutex);
+        while (!_destroyed)
         {
-            // Ignore
+            if (_pending.empty())
+            {
+                _cond.wait(lock);
+                continue;
+            }
+
+            auto next = _pending.begin();
+            if (chrono::steady_clock::now() < next->first)
+            {
+                _cond.wait_until(lock, next->first);
+                continue;
+            }
+
+            DiscoverReplyPrx reply = std::move(next->second);
+            _pending.erase(next);
+            _pendingClients.erase(reply->ice_getIdentity());
+            lock.unlock();
+
+            // Send the reply asynchronously, so that an unreachable client doesn't delay the other replies.
+            try
+            {
+                reply->replyAsync(_obj, [] {}, [](exception_ptr) {});
+            }
+            catch (const Ice::LocalException&)
+            {
+                // Ignore
+            }
+
+            lock.lock();
         }
     }
 
-private:
     const optional<Ice::ObjectPrx> _obj;
+    uniform_int_distribution<chrono::milliseconds::rep> _jitter;
+    minstd_rand _random{random_device{}()};
+
+    mutex _mutex;
+    condition_variable _cond;
+    bool _destroyed = false;
+
+    // The replies to send, by due time.
+    multimap<chrono::steady_clock::time_point, DiscoverReplyPrx> _pending;
+
+    // The clients with a reply in _pending.
+    set<Ice::Identity> _pendingClients;
+
+    std::thread _thread; // must be the last member, since the thread uses the other members
 };
 
 int
@@ -73,7 +157,13 @@ main(int argc, char* argv[])
             auto discoverAdapter = communicator->createObjectAdapter("Discover");
 
             auto hello = adapter->addWithUUID(make_shared<HelloI>());
-            auto d = make_shared<DiscoverI>(hello);
+            //
+            // The replies to lookups are delayed by up to Discover.ReplyJitter milliseconds.
+            //
+            auto d = make_shared<DiscoverI>(
+                hello,
+                chrono::milliseconds(
+                    communicator->getProperties()->getPropertyAsIntWithDefault("Discover.ReplyJitter", 250)));
             discoverAdapter->add(d, Ice::Identity{"discover"});
 
             discoverAdapter->activate();
@@ -0,0 +1,285 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "../../common/Time.h"
+#include "WeatherStation3.h"
+
+#include <Ice/Ice.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ClearSky;
+using namespace std;
+
+namespace
+{
+    /// The number of readings encoded and decoded for each encoding.
+    constexpr size_t defaultReadings = 1'000'000;
+
+    /// The number of readings in each batch sent with reportBatch.
+    constexpr size_t batchSize = 100;
+
+    /// The time between two readings, in ticks (100 nanoseconds): 10 ms.
+    constexpr int32_t samplePeriodTicks = 100'000;
+
+    /// A reading, before encoding.
+    struct Sample
+    {
+        double temperature;
+        double humidity;
+        double pressure;
+    };
+
+    /// A batch of readings in a columnar layout, before encoding.
+    struct Batch
+    {
+        int64_t startTime;
+        vector<int32_t> timeDeltas;
+        vector<double> temperatures;
+        vector<double> humidities;
+        vector<double> pressures;
+    };
+
+    /// Encodes the parameters of report, like the generated proxy code: sensorId and an AtmosphericConditions class
+    /// instance in an encapsulation.
+    void encodeClass(Ice::OutputStream& out, const string& sensorId, const Sample& sample, bool withPressure)
+    {
+        auto reading = make_shared<AtmosphericConditions>(
+            sample.temperature,
+            sample.humidity,
+            withPressure ? optional<double>{sample.pressure} : nullopt);
+
+        out.startEncapsulation();
+        out.write(sensorId);
+        out.write(reading);
+        out.writePendingValues();
+        out.endEncapsulation();
+    }
+
+    /// Encodes the parameters of reportConditions, like the generated proxy code: sensorId, a Conditions struct and
+    /// the tagged pressure in an encapsulation.
+    void encodeStruct(Ice::OutputStream& out, const string& sensorId, const Sample& sample, bool withPressure)
+    {
+        out.startEncapsulation();
+        out.write(sensorId);
+        out.write(Conditions{sample.temperature, sample.humidity});
+        out.write(1, withPressure ? optional<double>{sample.pressure} : nullopt);
+        out.endEncapsulation();
+    }
+
+    /// Encodes the parameters of reportBatch, like the generated proxy code: sensorId, the start time and one sequence
+    /// per column in an encapsulation.
+    void encodeBatch(Ice::OutputStream& out, const string& sensorId, const Batch& batch)
+    {
+        out.startEncapsulation();
+        out.write(sensorId);
+        out.write(batch.startTime);
+        out.write(batch.timeDeltas.data(), batch.timeDeltas.data() + batch.timeDeltas.size());
+        out.write(batch.temperatures.data(), batch.temperatures.data() + batch.temperatures.size());
+        out.write(batch.humidities.data(), batch.humidities.data() + batch.humidities.size());
+        out.write(batch.pressures.data(), batch.pressures.data() + batch.pressures.size());
+        out.endEncapsulation();
+    }
+
+    /// Decodes the parameters of report, like the generated dispatch code, and returns the sum of the decoded values.
+    double decodeClass(Ice::InputStream& in)
+    {
+        string sensorId;
+        AtmosphericConditionsPtr reading;
+
+        in.startEncapsulation();
+        in.read(sensorId);
+        in.read(reading);
+        in.readPendingValues();
+        in.endEncapsulation();
+        return reading->temperature + reading->humidity + reading->pressure.value_or(0.0);
+    }
+
+    /// Decodes the parameters of reportConditions, like the generated dispatch code, and returns the sum of the
+    /// decoded values.
+    double decodeStruct(Ice::InputStream& in)
+    {
+        string sensorId;
+        Conditions reading;
+        optional<double> pressure;
+
+        in.startEncapsulation();
+        in.read(sensorId);
+        in.read(reading);
+        in.read(1, pressure);
+        in.endEncapsulation();
+        return reading.temperature + reading.humidity + pressure.value_or(0.0);
+    }
+
+    /// Decodes the parameters of reportBatch, like the generated dispatch code, and aggregates the columns in place,
+    /// like ConsolePrinter3. Returns the sum of the decoded values.
+    double decodeBatch(Ice::InputStream& in)
+    {
+        string sensorId;
+        int64_t startTime;
+        pair<const int32_t*, const int32_t*> timeDeltas;
+        pair<const double*, const double*> temperatures;
+        pair<const double*, const double*> humidities;
+        pair<const double*, const double*> pressures;
+
+        in.startEncapsulation();
+        in.read(sensorId);
+        in.read(startTime);
+        in.read(timeDeltas);
+        in.read(temperatures);
+        in.read(humidities);
+        in.read(pressures);
+        in.endEncapsulation();
+
+        int64_t time = startTime;
+        double sum = 0.0;
+        for (ptrdiff_t i = 0; i < temperatures.second - temperatures.first; ++i)
+        {
+            time += timeDeltas.first[i];
+            sum += temperatures.first[i] + humidities.first[i] + pressures.first[i];
+        }
+        return time > startTime ? sum : 0.0;
+    }
+
+    /// Encodes and decodes items with one encoding, and prints the size and the average encode and decode times per
+    /// reading.
+    /// @param items The items to encode: samples or batches.
+    /// @param readingsPerItem The number of readings in each item.
+    /// @param readings The total number of readings to encode and decode.
+    template<typename Item, typename Encode, typename Decode>
+    void run(
+        const char* label,
+        const Ice::CommunicatorPtr& communicator,
+        const vector<Item>& items,
+        size_t readingsPerItem,
+        size_t readings,
+        Encode encode,
+        Decode decode)
+    {
+        const string sensorId = "sensor v3";
+        const size_t iterations = max(readings / readingsPerItem, size_t{1});
+
+        // Encode each item once, to measure the size and to have buffers to decode.
+        vector<vector<byte>> encoded;
+        encoded.reserve(items.size());
+        for (const auto& item : items)
+        {
+            Ice::OutputStream out{communicator};
+            encode(out, sensorId, item);
+            auto [begin, end] = out.finished();
+            encoded.emplace_back(begin, end);
+        }
+
+        // Accumulate the encoded sizes and decoded values, so that the compiler can't skip the work.
+        size_t totalSize = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            // Like an invocation, each encoding uses a new output stream.
+            Ice::OutputStream out{communicator};
+            encode(out, sensorId, items[i % items.size()]);
+            totalSize += out.b.size();
+        }
+        auto encodeTime = (chrono::steady_clock::now() - start) / (iterations * readingsPerItem);
+
+        double sum = 0.0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const vector<byte>& buffer = encoded[i % encoded.size()];
+            Ice::InputStream in{communicator, make_pair(buffer.data(), buffer.data() + buffer.size())};
+            sum += decode(in);
+        }
+        auto decodeTime = (chrono::steady_clock::now() - start) / (iterations * readingsPerItem);
+
+        if (totalSize == 0 || sum == 0.0)
+        {
+            cout << "unexpected empty encoding" << endl;
+        }
+
+        cout << "  " << left << setw(26) << label << right << fixed << setprecision(1) << setw(7)
+             << static_cast<double>(encoded.front().size()) / static_cast<double>(readingsPerItem) << " bytes"
+             << setw(8) << chrono::duration_cast<chrono::nanoseconds>(encodeTime).count() << " ns encode" << setw(8)
+             << chrono::duration_cast<chrono::nanoseconds>(decodeTime).count() << " ns decode" << endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    Ice::CommunicatorHolder communicator{Ice::initialize(argc, argv)};
+
+    // The first remaining argument is the number of readings.
+    size_t readings = argc > 1 ? static_cast<size_t>(max(1L, atol(argv[1]))) : defaultReadings;
+
+    // Generate the samples with a fixed seed.
+    mt19937 gen{42};
+    uniform_real_distribution<> tempDist{19.0, 23.0};
+    uniform_real_distribution<> humidityDist{45.0, 55.0};
+    uniform_real_distribution<> pressureDist{1000.0, 1050.0};
+    vector<Sample> samples(1024);
+    for (auto& sample : samples)
+    {
+        sample = {tempDist(gen), humidityDist(gen), pressureDist(gen)};
+    }
+
+    // Group the samples in batches, taken every 10 ms.
+    vector<Batch> batches;
+    for (size_t first = 0; first + batchSize <= samples.size(); first += batchSize)
+    {
+        Batch batch{Time::toTimeStamp(chrono::system_clock::now()), {}, {}, {}, {}};
+        for (size_t i = first; i < first + batchSize; ++i)
+        {
+            batch.timeDeltas.push_back(i == first ? 0 : samplePeriodTicks);
+            batch.temperatures.push_back(samples[i].temperature);
+            batch.humidities.push_back(samples[i].humidity);
+            batch.pressures.push_back(samples[i].pressure);
+        }
+        batches.push_back(std::move(batch));
+    }
+
+    cout << "Encoding and decoding " << readings << " readings (the parameters of report requests), per reading..."
+         << endl;
+
+    run(
+        "class",
+        communicator.communicator(),
+        samples,
+        1,
+        readings,
+        [](Ice::OutputStream& out, const string& id, const Sample& sample) { encodeClass(out, id, sample, false); },
+        decodeClass);
+    run(
+        "class + optional pressure",
+        communicator.communicator(),
+        samples,
+        1,
+        readings,
+        [](Ice::OutputStream& out, const string& id, const Sample& sample) { encodeClass(out, id, sample, true); },
+        decodeClass);
+    run(
+        "struct",
+        communicator.communicator(),
+        samples,
+        1,
+        readings,
+        [](Ice::OutputStream& out, const string& id, const Sample& sample) { encodeStruct(out, id, sample, false); },
+        decodeStruct);
+    run(
+        "struct + tagged pressure",
+        communicator.communicator(),
+        samples,
+        1,
+        readings,
+        [](Ice::OutputStream& out, const string& id, const Sample& sample) { encodeStruct(out, id, sample, true); },
+        decodeStruct);
+    run("batch of 100, columnar", communicator.communicator(), batches, batchSize, readings, encodeBatch, decodeBatch);
+
+    return 0;
+}
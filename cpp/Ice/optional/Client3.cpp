@@ -0,0 +1,98 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "../../common/Time.h"
+#include "WeatherStation3.h"
+
+#include <Ice/Ice.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace ClearSky;
+
+int
+main(int argc, char* argv[])
+{
+    // Create an Ice communicator. We'll use this communicator to create proxies and manage outgoing connections
+    Ice::CommunicatorPtr communicator = Ice::initialize(argc, argv);
+
+    // Make sure the communicator is destroyed at the end of this scope.
+    Ice::CommunicatorHolder communicatorHolder{communicator};
+
+    // Create a proxy to the Weather station.
+    WeatherStationPrx weatherStation{communicator, "weatherStation:tcp -p 4061"};
+
+    // Initialize random number generators.
+    std::mt19937 gen{std::random_device{}()};
+    std::uniform_real_distribution<> tempDist{19.0, 23.0};         // Temperature range: 19.0 to 23.0
+    std::uniform_real_distribution<> humidityDist{45.0, 55.0};     // Humidity range: 45.0 to 55.0
+    std::uniform_real_distribution<> pressureDist{1000.0, 1050.0}; // Pressure range: 1000 to 1050
+
+    // Generate random temperature and humidity values.
+    double randomTemperature = tempDist(gen);
+    double randomHumidity = humidityDist(gen);
+    double randomPressure = pressureDist(gen);
+
+    // Report this reading to the weather station, with the compact struct encoding.
+    try
+    {
+        weatherStation->reportConditions("sensor v3", Conditions{randomTemperature, randomHumidity}, randomPressure);
+    }
+    catch (const Ice::OperationNotExistException&)
+    {
+        // A version 1 or version 2 weather station doesn't implement reportConditions: fall back to report.
+        auto reading = std::make_shared<AtmosphericConditions>(randomTemperature, randomHumidity, randomPressure);
+        weatherStation->report("sensor v3", reading);
+    }
+
+    // A high-frequency sensor takes a reading every 10 ms, and sends its readings in batches of 100 with reportBatch.
+    // The time of each reading is sent as a delta from the previous reading, in ticks (100 nanoseconds).
+    constexpr std::size_t batchSize = 100;
+    constexpr std::chrono::milliseconds samplePeriod{10};
+    using Ticks = std::chrono::duration<std::int32_t, std::ratio<1, 10'000'000>>;
+
+    auto startTime = std::chrono::system_clock::now();
+    std::vector<std::int32_t> timeDeltas;
+    std::vector<double> temperatures;
+    std::vector<double> humidities;
+    std::vector<double> pressures;
+    timeDeltas.reserve(batchSize);
+    temperatures.reserve(batchSize);
+    humidities.reserve(batchSize);
+    pressures.reserve(batchSize);
+    for (std::size_t i = 0; i < batchSize; ++i)
+    {
+        timeDeltas.push_back(i == 0 ? 0 : std::chrono::duration_cast<Ticks>(samplePeriod).count());
+        temperatures.push_back(tempDist(gen));
+        humidities.push_back(humidityDist(gen));
+        pressures.push_back(pressureDist(gen));
+    }
+
+    try
+    {
+        weatherStation->reportBatch(
+            "sensor v3",
+            Time::toTimeStamp(startTime),
+            {timeDeltas.data(), timeDeltas.data() + timeDeltas.size()},
+            {temperatures.data(), temperatures.data() + temperatures.size()},
+            {humidities.data(), humidities.data() + humidities.size()},
+            {pressures.data(), pressures.data() + pressures.size()});
+    }
+    catch (const Ice::OperationNotExistException&)
+    {
+        // A version 1 or version 2 weather station doesn't implement reportBatch: fall back to one report per reading.
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            weatherStation->report(
+                "sensor v3",
+                std::make_shared<AtmosphericConditions>(temperatures[i], humidities[i], pressures[i]));
+        }
+    }
+
+    std::cout << "sensor v3: sent 1 reading and a batch of " << batchSize << " readings to weather station"
+              << std::endl;
+
+    return 0;
+}
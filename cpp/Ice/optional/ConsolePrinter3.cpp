@@ -0,0 +1,88 @@
+// Copyright (c) ZeroC, Inc.
+
+#include "ConsolePrinter3.h"
+#include "../../common/Time.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+void
+Server::ConsolePrinter::report(string sensorId, ClearSky::AtmosphericConditionsPtr reading, const Ice::Current&)
+{
+    cout << sensorId << " reported " << reading << " to station v3" << endl;
+}
+
+void
+Server::ConsolePrinter::reportConditions(
+    string sensorId,
+    ClearSky::Conditions reading,
+    optional<double> pressure,
+    const Ice::Current&)
+{
+    cout << sensorId << " reported " << reading;
+    if (pressure)
+    {
+        cout << " with pressure = " << *pressure;
+    }
+    cout << " to station v3" << endl;
+}
+
+void
+Server::ConsolePrinter::reportBatch(
+    string sensorId,
+    int64_t startTime,
+    pair<const int32_t*, const int32_t*> timeDeltas,
+    pair<const double*, const double*> temperatures,
+    pair<const double*, const double*> humidities,
+    pair<const double*, const double*> pressures,
+    const Ice::Current&)
+{
+    const ptrdiff_t count = temperatures.second - temperatures.first;
+    const bool hasPressures = pressures.first != pressures.second;
+    if (timeDeltas.second - timeDeltas.first != count || humidities.second - humidities.first != count ||
+        (hasPressures && pressures.second - pressures.first != count))
+    {
+        throw Ice::DispatchException{
+            __FILE__,
+            __LINE__,
+            Ice::ReplyStatus::InvalidData,
+            "all the sequences of a batch must have the same length"};
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    // The columns point into the request buffer: we aggregate them in place, without creating an object per reading.
+    int64_t firstTime = startTime + timeDeltas.first[0];
+    int64_t lastTime = startTime;
+    double temperatureSum = 0.0;
+    double humiditySum = 0.0;
+    double pressureSum = 0.0;
+    for (ptrdiff_t i = 0; i < count; ++i)
+    {
+        lastTime += timeDeltas.first[i];
+        temperatureSum += temperatures.first[i];
+        humiditySum += humidities.first[i];
+        if (hasPressures)
+        {
+            pressureSum += pressures.first[i];
+        }
+    }
+
+    auto average = [count](double sum) { return sum / static_cast<double>(count); };
+    auto firstTimePoint = Time::toTimePoint(firstTime);
+    auto duration = chrono::duration_cast<chrono::milliseconds>(Time::toTimePoint(lastTime) - firstTimePoint);
+
+    cout << sensorId << " reported " << count << " readings taken over " << duration.count() << " ms starting at "
+         << Time::formatTime(firstTimePoint) << ": average temperature = " << average(temperatureSum)
+         << ", average humidity = " << average(humiditySum);
+    if (hasPressures)
+    {
+        cout << ", average pressure = " << average(pressureSum);
+    }
+    cout << " to station v3" << endl;
+}
@@ -0,0 +1,40 @@
+// Copyright (c) ZeroC, Inc.
+
+#ifndef CONSOLE_PRINTER3_H
+#define CONSOLE_PRINTER3_H
+
+#include "WeatherStation3.h"
+
+namespace Server
+{
+    /// ConsolePrinter is an Ice servant that implements Slice interface ClearSky::WeatherStation. It prints all
+    /// information reported by the sensors to the console.
+    class ConsolePrinter : public ClearSky::WeatherStation
+    {
+    public:
+        // Implements the pure virtual function in the base class (ClearSky::WeatherStation) generated by the Slice
+        // compiler.
+        void report(std::string sensorId, ClearSky::AtmosphericConditionsPtr reading, const Ice::Current&) override;
+
+        // Implements the pure virtual function in the base class (ClearSky::WeatherStation) generated by the Slice
+        // compiler.
+        void reportConditions(
+            std::string sensorId,
+            ClearSky::Conditions reading,
+            std::optional<double> pressure,
+            const Ice::Current&) override;
+
+        // Implements the pure virtual function in the base class (ClearSky::WeatherStation) generated by the Slice
+        // compiler.
+        void reportBatch(
+            std::string sensorId,
+            std::int64_t startTime,
+            std::pair<const std::int32_t*, const std::int32_t*> timeDeltas,
+            std::pair<const double*, const double*> temperatures,
+            std::pair<const double*, const double*> humidities,
+            std::pair<const double*, const double*> pressures,
+            const Ice::Current&) override;
+    };
+}
+
+#endif
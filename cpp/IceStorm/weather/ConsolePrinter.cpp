@@ -1,6 +1,7 @@
 // Copyright (c) ZeroC, Inc.
 
 #include "ConsolePrinter.h"
+#include "../../common/Time.h"
 
 #include <iostream>
 
@@ -15,3 +16,43 @@ Server::ConsolePrinter::report(
 {
     cout << sensorId << " measured " << reading << " at " << timeStamp << endl;
 }
+
+void
+Server::ConsolePrinter::reportBatch(
+    string sensorId,
+    int64_t startTime,
+    pair<const int32_t*, const int32_t*> timeDeltas,
+    pair<const double*, const double*> temperatures,
+    pair<const double*, const double*> humidities,
+    const Ice::Current&)
+{
+    const ptrdiff_t count = temperatures.second - temperatures.first;
+    if (timeDeltas.second - timeDeltas.first != count || humidities.second - humidities.first != count)
+    {
+        // We don't throw an exception back to IceStorm: the sensor would never see it.
+        cout << sensorId << " sent an invalid batch of readings" << endl;
+        return;
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    // The columns point into the request buffer: we aggregate them in place, without creating an object per reading.
+    int64_t firstTime = startTime + timeDeltas.first[0];
+    int64_t lastTime = startTime;
+    double temperatureSum = 0.0;
+    double humiditySum = 0.0;
+    for (ptrdiff_t i = 0; i < count; ++i)
+    {
+        lastTime += timeDeltas.first[i];
+        temperatureSum += temperatures.first[i];
+        humiditySum += humidities.first[i];
+    }
+
+    cout << sensorId << " measured " << count << " readings between "
+         << Time::formatTime(Time::toTimePoint(firstTime)) << " and " << Time::formatTime(Time::toTimePoint(lastTime))
+         << ": { Temperature = " << temperatureSum / static_cast<double>(count)
+         << "°C, Humidity = " << humiditySum / static_cast<double>(count) << "% } on average" << endl;
+}
@@ -19,6 +19,16 @@ namespace Server
             std::string timeStamp,
             ClearSky::AtmosphericConditionsPtr reading,
             const Ice::Current&) override;
+
+        // Implements the pure virtual function in the base class (ClearSky::WeatherStation) generated by the Slice
+        // compiler.
+        void reportBatch(
+            std::string sensorId,
+            std::int64_t startTime,
+            std::pair<const std::int32_t*, const std::int32_t*> timeDeltas,
+            std::pair<const double*, const double*> temperatures,
+            std::pair<const double*, const double*> humidities,
+            const Ice::Current&) override;
     };
 }
 
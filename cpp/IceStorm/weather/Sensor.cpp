@@ -5,10 +5,13 @@
 
 #include <Ice/Ice.h>
 #include <IceStorm/IceStorm.h>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <optional>
 #include <random>
 #include <thread>
+#include <vector>
 
 using namespace ClearSky;
 using namespace std;
@@ -78,25 +81,53 @@ main(int argc, char* argv[])
     std::uniform_real_distribution<> tempDist{19.0, 23.0};     // Temperature range: 19.0 to 23.0
     std::uniform_real_distribution<> humidityDist{45.0, 55.0}; // Humidity range: 45.0 to 55.0
 
-    while (true)
+    // The sensor takes a reading every 100 ms and publishes its readings in batches of 10, so IceStorm forwards one
+    // request per second to each weather station instead of 10. The readings are sent in a columnar layout, with the
+    // time of each reading encoded as a delta from the previous reading, in ticks (100 nanoseconds).
+    constexpr std::chrono::milliseconds samplePeriod{100};
+    constexpr size_t batchSize = 10;
+
+    int64_t startTime = 0;
+    int64_t lastTime = 0;
+    vector<int32_t> timeDeltas;
+    vector<double> temperatures;
+    vector<double> humidities;
+    timeDeltas.reserve(batchSize);
+    temperatures.reserve(batchSize);
+    humidities.reserve(batchSize);
+
+    bool shutdown = false;
+    while (!shutdown)
     {
-        // Generate random temperature and humidity values.
-        double randomTemperature = tempDist(gen);
-        double randomHumidity = humidityDist(gen);
-
-        auto now = std::chrono::system_clock::now();
-        const string timeStamp = Time::formatTime(now);
+        int64_t now = Time::toTimeStamp(std::chrono::system_clock::now());
+        if (timeDeltas.empty())
+        {
+            startTime = now;
+            lastTime = now;
+        }
+        timeDeltas.push_back(static_cast<int32_t>(now - lastTime));
+        lastTime = now;
 
-        // Create an AtmosphericConditions object with random values.
-        auto reading = std::make_shared<AtmosphericConditions>(randomTemperature, randomHumidity);
+        // Generate random temperature and humidity values.
+        temperatures.push_back(tempDist(gen));
+        humidities.push_back(humidityDist(gen));
 
-        // Report this reading to the weather station.
-        weatherStation->report(sensorId, timeStamp, reading);
+        // Wait for the next reading or for the shutdown signal.
+        shutdown = shutdownFuture.wait_for(samplePeriod) == std::future_status::ready;
 
-        // Wait for second or for the shutdown signal.
-        if (shutdownFuture.wait_for(std::chrono::seconds(1)) == std::future_status::timeout)
+        // Report the readings to the weather station when the batch is full, or when we shut down.
+        if (shutdown || timeDeltas.size() == batchSize)
         {
-            break;
+            weatherStation->reportBatch(
+                sensorId,
+                startTime,
+                {timeDeltas.data(), timeDeltas.data() + timeDeltas.size()},
+                {temperatures.data(), temperatures.data() + temperatures.size()},
+                {humidities.data(), humidities.data() + humidities.size()});
+
+            timeDeltas.clear();
+            temperatures.clear();
+            humidities.clear();
         }
     }
 
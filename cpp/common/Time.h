@@ -56,7 +56,7 @@ namespace Time
     /// Converts a time stamp to a time point.
     /// @param timeStamp The time stamp.
     /// @return The time point.
-    std::chrono::system_clock::time_point toTimePoint(std::int64_t timeStamp)
+    inline std::chrono::system_clock::time_point toTimePoint(std::int64_t timeStamp)
     {
         const int daysBeforeEpoch = 719162;
 